@@ -6,12 +6,14 @@
 #include "PokerGame.h"
 #include "../utils/Logger.h"
 #include "game/PokerEngine.h"
+#include "game/analysis/DrawTable.h"
 #include "game/player/AIPokerPlayer.h"
 #include "game/player/HumanPokerPlayer.h"
 #include "game/resources/PokerHand.h"
 #include <climits>
 #include <cstdlib>
 #include <ctime>
+#include <filesystem>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -32,8 +34,10 @@ PokerGame::PokerGame(EnginePtr engine) : gameEngine(engine) {}
 
 void PokerGame::run()
 {
-   initialize();
-   setupPlayers();
+   if (!gameEngine->isHeadless()) { ///< Headless players are already seated
+      initialize();
+      setupPlayers();
+   }
    gameEngine->startGame();
    displayResults();
 }
@@ -68,12 +72,20 @@ void PokerGame::initialize()
    Logger::console("Ante set to: " + PokerEngine::formatCurrency(ante));
    Logger::console("");
    gameEngine->setAnte(ante);
+
+   ///< Optimizing players look draws up in a generated table, if present
+   if (filesystem::exists(DrawTable::DEFAULT_PATH)) {
+      DrawTable::install(DrawTable::DEFAULT_PATH);
+   }
 }
 
 int PokerGame::promptStrategy()
 {
    Logger::console("Choose an AI Strategy:");
-   Logger::console("1: Conservative, 2: Balanced, 3: Aggressive, [4]: Random");
+   Logger::console(
+       "1: Conservative, 2: Balanced, 3: Aggressive, 4: Optimizing, "
+       "[5]: Random"
+   );
 
    string input;
    getline(cin, input);
@@ -89,6 +101,9 @@ int PokerGame::promptStrategy()
    } else if (input == "3") {
       strategy = (int)AIPokerPlayer::Strategy::AGGRESSIVE;
       Logger::console("You selected Aggressive strategy.");
+   } else if (input == "4") {
+      strategy = (int)AIPokerPlayer::Strategy::OPTIMIZING;
+      Logger::console("You selected Optimizing strategy.");
    } else {
       strategy = 0;
       Logger::console("You selected Random strategy.");
@@ -101,11 +116,14 @@ void PokerGame::setupPlayers()
 {
    int n = 0;
    using AIS = AIPokerPlayer::Strategy;
-   int sValues[] = {AIS::CONSERVATIVE, AIS::BALANCED, AIS::AGGRESSIVE};
+   int sValues[] = {
+       AIS::CONSERVATIVE, AIS::BALANCED, AIS::AGGRESSIVE, AIS::OPTIMIZING
+   };
    map<int, string> sNames = {
        {AIS::CONSERVATIVE, "Conservative"},
        {AIS::BALANCED, "Balanced"},
-       {AIS::AGGRESSIVE, "Aggressive"}
+       {AIS::AGGRESSIVE, "Aggressive"},
+       {AIS::OPTIMIZING, "Optimizing"}
    };
    AIPokerPlayer::Strategy strategy;
    int s = promptStrategy();
@@ -134,7 +152,7 @@ void PokerGame::setupPlayers()
 
       if (s == 0) {
          srand(time(0));
-         strategy = static_cast<AIPokerPlayer::Strategy>(sValues[rand() % 3]);
+         strategy = static_cast<AIPokerPlayer::Strategy>(sValues[rand() % 4]);
       } else {
          strategy = static_cast<AIPokerPlayer::Strategy>(s);
       }
@@ -31,6 +31,8 @@ class PokerGame
 
    /**
     * @brief Runs the poker game.
+    * @details A headless engine skips the ante and player prompts and plays
+    * with the players already added to it.
     */
    virtual void run();
 
@@ -5,21 +5,75 @@
 
 #include "PokerEngine.h"
 #include "../../utils/Logger.h"
+#include "history/HandHistory.h"
 #include "player/PokerPlayer.h"
 #include "resources/CardCollection.h"
 #include "resources/Deck.h"
 #include "resources/PokerHand.h"
-#include <climits>
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <iomanip>
 #include <map>
 #include <sstream>
+#include <stdexcept>
 
 using namespace std;
 using PlayerList = vector<shared_ptr<PokerPlayer>>;
 using PokerPlayerPtr = shared_ptr<PokerPlayer>;
 using PokerHandPtr = shared_ptr<PokerHand>;
 
+namespace
+{
+/**
+ * @brief Returns the recorded action of a player who has just bet.
+ *
+ * @param state The player's state after betting.
+ */
+HandHistory::Action toAction(PokerPlayer::Status state)
+{
+   switch (state) {
+      case PokerPlayer::Status::FOLDED:
+         return HandHistory::FOLD;
+      case PokerPlayer::Status::ALLIN:
+         return HandHistory::ALL_IN;
+      case PokerPlayer::Status::RAISING:
+         return HandHistory::RAISE;
+      default:
+         return HandHistory::CALL;
+   }
+}
+} // namespace
+
+template <typename T> struct PokerEngine::Pending
+{
+   PokerEngine &engine;   ///< The engine playing the hand
+   Task<T> decision;      ///< The player's decision
+   bool suspended{false}; ///< Whether the hand had to wait for it
+
+   bool await_ready() const noexcept
+   {
+      return decision.isReady();
+   }
+
+   void await_suspend(coroutine_handle<> hand)
+   {
+      suspended = true;
+      engine.redirect.reset();
+      decision.await_suspend(hand);
+   }
+
+   T await_resume()
+   {
+      if (suspended) {
+         engine.redirect.emplace(
+             engine.headless ? engine.output : Logger::getConsole()
+         );
+      }
+      return decision.get();
+   }
+};
+
 // Static Functions
 string PokerEngine::formatCurrency(double amount)
 {
@@ -54,21 +108,94 @@ PokerEngine::PokerEngine(shared_ptr<Deck> deck)
 // Game Phases
 void PokerEngine::startGame()
 {
-   Logger::debug("Starting Game...");
-   anteUp();
-   dealCards();
-   Logger::debug("Starting game loop...");
-   while (currentRound < 2) {
-      advanceRound();
-      bettingRound();
-      if (currentRound == 1) {
-         drawingRound();
+   if (isPlaying()) {
+      Logger::warn("The last hand is still waiting for a decision.");
+      return;
+   }
+   game = play();
+   if (game.isReady()) {
+      redirect.reset();
+      game.get();
+   }
+}
+
+Task<> PokerEngine::play()
+{
+   redirect.emplace(headless ? output : Logger::getConsole());
+   for (Turn turn = advance(); turn.phase != OVER; turn = advance()) {
+      auto player = players.at(turn.seat);
+      if (turn.phase == BETTING) {
+         Pending<double> decision{*this, player->decideBet()};
+         double amount = co_await decision;
+         handleBet(player, amount);
+      } else {
+         Pending<vector<int>> decision{*this, player->decideDiscard()};
+         auto discardIdxs = co_await decision;
+         handleDraw(player, discardIdxs);
       }
+      acting = false;
+      prompt("Press Enter to continue...");
    }
+   redirect.reset();
+}
+
+Task<int> PokerEngine::playSession(int count)
+{
+   ///< Destroying an unfinished session abandons its hand with it
+   unique_ptr<PokerEngine, void (*)(PokerEngine *)> seated(
+       this, [](PokerEngine *engine) { engine->abandon(); }
+   );
+   int played = 0;
+   while (played < count) {
+      int solvent = 0;
+      for (auto &player : players) {
+         solvent += player->getBalance() >= ante;
+      }
+      if (solvent < 2) {
+         Logger::debug("Fewer than two players can pay the ante.");
+         break;
+      }
+      reset();
+      game = play();
+      co_await game;
+      payWinners();
+      setDealer(getDealer() + 1);
+      ++played;
+   }
+   Logger::debug("Session over after " + to_string(played) + " hands.");
+   co_return played;
+}
+
+bool PokerEngine::isPlaying() const
+{
+   return !game.isReady();
+}
+
+PokerEngine::Turn PokerEngine::step()
+{
+   Logger::Redirect redirect(headless ? output : Logger::getConsole());
+   return advance();
+}
+
+PokerEngine::Turn PokerEngine::step(const Action &action)
+{
+   if (isPlaying()) {
+      throw logic_error("The hand is being played by play().");
+   }
+   Logger::Redirect redirect(headless ? output : Logger::getConsole());
+   apply(action);
+   acting = false;
+   return advance();
+}
+
+PokerEngine::Phase PokerEngine::getPhase() const
+{
+   return phase;
 }
 
 multimap<long long, PokerPlayer::Outcome> PokerEngine::endGame(bool output)
 {
+   Logger::Redirect redirect(headless ? this->output : Logger::getConsole());
    if (output) {
       auto winners = determineWinners();
       printResults(winners);
@@ -79,10 +206,69 @@ multimap<long long, PokerPlayer::Outcome> PokerEngine::endGame(bool output)
 // Utility Functions
 void PokerEngine::addPlayer(PokerPlayerPtr player)
 {
+   if (headless && player->readsConsole()) {
+      Logger::warn("A headless game cannot seat " + player->getName() + ".");
+      return;
+   }
    Logger::debug("Adding player: " + player->getName());
    players.push_back(player);
 }
 
+void PokerEngine::clearPlayers()
+{
+   Logger::debug("Removing " + to_string(players.size()) + " players.");
+   abandon();
+   players.clear();
+   currentPlayerIndex = -1;
+   dealer = -1;
+}
+
+void PokerEngine::reset()
+{
+   Logger::debug("Resetting for a new hand.");
+   abandon();
+   if (recorder) {
+      recorder->abortHand(); ///< A hand stepped but never finished
+   }
+   deck->reset();
+   discards->clear();
+   for (auto &player : players) {
+      player->reset();
+   }
+   currentPlayerIndex = -1;
+   position = -1;
+   currentRound = 0;
+   phase = ANTE;
+   acting = false;
+   pot = 0.0;
+   blind = 0.0;
+   lastFolded = -1;
+   cardsDealt = 0;
+}
+
+void PokerEngine::setHeadless(bool headless, ostream *output)
+{
+   Logger::debug(string("Headless mode ") + (headless ? "on." : "off."));
+   this->headless = headless;
+   this->output = output;
+}
+
+void PokerEngine::setRecorder(shared_ptr<HistoryWriter> recorder)
+{
+   Logger::debug(string("Recording ") + (recorder ? "on." : "off."));
+   this->recorder = recorder;
+}
+
+void PokerEngine::setDealOrder(const vector<CardId> *cards)
+{
+   dealOrder = cards;
+}
+
+bool PokerEngine::isHeadless() const
+{
+   return headless;
+}
+
 PokerPlayerPtr PokerEngine::getCurrentPlayer() const
 {
    if (currentPlayerIndex >= 0 && currentPlayerIndex < players.size()) {
@@ -102,6 +288,30 @@ double PokerEngine::getPot() const
    return pot;
 }
 
+int PokerEngine::getContenders() const
+{
+   return static_cast<int>(count_if(
+       players.begin(), players.end(),
+       [](const auto &player) {
+          return player->getState() != PokerPlayer::Status::FOLDED;
+       }
+   ));
+}
+
+void PokerEngine::setDealer(int seat)
+{
+   dealer = seat;
+}
+
+int PokerEngine::getDealer() const
+{
+   int seats = static_cast<int>(players.size());
+   if (seats == 0) {
+      return -1;
+   }
+   return dealer < 0 ? seats - 1 : dealer % seats;
+}
+
 void PokerEngine::setAnte(double ante)
 {
    Logger::debug("Setting ante to: " + formatCurrency(ante) + ".");
@@ -113,8 +323,16 @@ void PokerEngine::anteUp()
 {
    Logger::console("Ante's Up!");
    Logger::console("");
-   for (auto &player : players) {
-      if (!player->bet(ante)) {
+   for (int i = 0; i < players.size(); i++) {
+      auto &player = players.at(i);
+      if (recorder) {
+         recorder->seat(i, player->show().playerBalance);
+      }
+      bool paid = player->bet(ante);
+      if (recorder) {
+         recorder->ante(i, paid ? ante : 0.0);
+      }
+      if (!paid) {
          player->setState(PokerPlayer::Status::FOLDED);
          Logger::debug(
              player->getName() +
@@ -125,8 +343,8 @@ void PokerEngine::anteUp()
              player->getName() + " has paid the ante of " +
              formatCurrency(ante) + "."
          );
+         pot += ante;
       }
-      pot += ante;
    }
    int nPlayers = getPlayersByState(PokerPlayer::Status::WAITING).size();
    Logger::debug(to_string(nPlayers) + " players have paid the ante.");
@@ -134,19 +352,35 @@ void PokerEngine::anteUp()
 
 void PokerEngine::dealCards()
 {
-   PlayerList waiting = getPlayersByState(PokerPlayer::Status::WAITING);
+   PlayerList waiting; ///< In dealing order, from the dealer's left
+   for (size_t i = 1; i <= players.size(); ++i) {
+      auto &player = players[(getDealer() + i) % players.size()];
+      if (player->getState() == PokerPlayer::Status::WAITING) {
+         waiting.push_back(player);
+      }
+   }
    int perPlayer = 5;
    int nPlayers = waiting.size();
    Logger::debug("Deck size is: " + to_string(deck->size()));
    shuffleDeck();
    Logger::console("Dealing cards to " + to_string(nPlayers) + " players.");
    Logger::console("");
+   ///< Card ids in the order each player was dealt them, when recording
+   vector<array<CardId, HandHistory::MAX_CARDS>> ids(
+       recorder ? waiting.size() : 0
+   );
    for (int i = 0; i < perPlayer; ++i) {
-      for (auto &player : waiting) {
+      for (size_t p = 0; p < waiting.size(); ++p) {
+         auto &player = waiting[p];
          Card::ORIENTATION orientation = player->type == UserType::AI
                                              ? Card::ORIENTATION::FACE_DOWN
                                              : Card::ORIENTATION::FACE_UP;
-         player->receive(CardCollection({deck->deal(orientation)}));
+         CardCollection dealt;
+         dealt.add(dealCard(), orientation);
+         if (recorder) {
+            ids[p][i] = dealt.get(0)->getId();
+         }
+         player->receive(dealt);
       }
    }
    for (auto &player : waiting) {
@@ -156,33 +390,12 @@ void PokerEngine::dealCards()
        to_string(nPlayers) + " players were dealt " + to_string(perPlayer) +
        " cards each."
    );
-   prompt("Press Enter to continue...");
-}
-
-void PokerEngine::bettingRound()
-{
-   for (int i = 0; i < players.size(); i++) {
-      auto player = players.at(i);
-      if (player->getState() == PokerPlayer::Status::ACTIVE) {
-         handleBet(player);
-         currentPlayerIndex = i;
-         prompt("Press Enter to continue...");
-      }
-   }
-   currentPlayerIndex = -1;
-}
-
-void PokerEngine::drawingRound()
-{
-   for (int i = 0; i < players.size(); i++) {
-      auto player = players.at(i);
-      if (player->getState() != PokerPlayer::Status::FOLDED) {
-         handleDraw(player);
-         currentPlayerIndex = i;
-         prompt("Press Enter to continue...");
+   if (recorder) {
+      for (size_t p = 0; p < waiting.size(); ++p) {
+         recorder->deal(getSeat(waiting[p]), ids[p].data(), perPlayer);
       }
    }
-   currentPlayerIndex = -1;
+   prompt("Press Enter to continue...");
 }
 
 void PokerEngine::advanceRound()
@@ -222,6 +435,9 @@ int PokerEngine::getCurrentRound() const
 
 void PokerEngine::prompt(string message)
 {
+   if (headless) {
+      return;
+   }
    string confirmation;
    Logger::console(message, false);
    getline(cin, confirmation);
@@ -230,17 +446,27 @@ void PokerEngine::prompt(string message)
 }
 
 // Private Functions
-void PokerEngine::handleDraw(PokerPlayerPtr player)
+void PokerEngine::handleDraw(PokerPlayerPtr player, vector<int> discardIdxs)
 {
    if (player->getState() != PokerPlayer::Status::FOLDED) {
       Card::ORIENTATION orientation = player->type == UserType::AI
                                           ? Card::ORIENTATION::FACE_DOWN
                                           : Card::ORIENTATION::FACE_UP;
-      auto discardIdxs = player->discard();
+      if (recorder) {
+         recorder->discard(getSeat(player), discardIdxs);
+      }
       if (!discardIdxs.empty()) {
          auto replacements = CardCollection();
          for (auto &idx : discardIdxs) {
-            replacements.add(deck->deal(orientation));
+            replacements.add(dealCard(), orientation);
+         }
+         if (recorder) {
+            CardId ids[HandHistory::MAX_CARDS];
+            int count = min<int>(replacements.size(), HandHistory::MAX_CARDS);
+            for (int i = 0; i < count; ++i) {
+               ids[i] = replacements.get(i)->getId();
+            }
+            recorder->replace(getSeat(player), ids, count);
          }
          auto discarded = player->replace(discardIdxs, replacements);
          for (int i = 0; i < discarded.size(); i++) {
@@ -275,29 +501,32 @@ void PokerEngine::handleDraw(PokerPlayerPtr player)
    }
 }
 
-void PokerEngine::handleBet(PokerPlayerPtr player)
+void PokerEngine::handleBet(PokerPlayerPtr player, double amount)
 {
-   if (player->getState() == PokerPlayer::Status::ACTIVE) {
-      double b = player->bet();
-      Logger::debug(
-          "Engine received bet: " + formatCurrency(b) + " from " +
-          player->getName() + "."
+   Logger::debug(
+       "Engine received bet: " + formatCurrency(amount) + " from " +
+       player->getName() + "."
+   );
+   pot += amount;
+   if (player->getState() == PokerPlayer::Status::FOLDED) {
+      lastFolded = getSeat(player);
+   }
+   if (recorder) {
+      recorder->bet(getSeat(player), toAction(player->getState()), amount);
+   }
+   if (amount > blind) {
+      Logger::debug("Setting new blind to: " + formatCurrency(amount));
+      Logger::console(
+          "The minimum bet is now: " + formatCurrency(amount) + "!"
       );
-      pot += b;
-      if (b > blind) {
-         Logger::debug("Setting new blind to: " + formatCurrency(b));
-         Logger::console("The minimum bet is now: " + formatCurrency(b) + "!");
-         Logger::console("");
-         blind = max(blind, b);
-      }
-   } else {
-      Logger::debug(player->getName() + " is not an active player.");
+      Logger::console("");
+      blind = max(blind, amount);
    }
 }
 
 multimap<int, PokerPlayer::Outcome> PokerEngine::determineWinners()
 {
-   long long maxScore = LLONG_MIN;
+   HandRank maxRank;
    int winnerIdx = -1, tieWinnerIdx = -1;
    string maxCategory;
    string winner;
@@ -309,20 +538,22 @@ multimap<int, PokerPlayer::Outcome> PokerEngine::determineWinners()
       auto player = players.at(i);
       const auto &outcome = player->show();
       const PokerHandPtr &hand = outcome.playerHand;
-      long long handScore = hand->getScore();
+      HandRank handRank = outcome.playerRank;
       string handDescription = hand->getDescription();
       outcomes.push_back(outcome);
       if (player->getState() != PokerPlayer::Status::FOLDED) {
-         if (handScore > maxScore) {
-            maxScore = handScore;
+         if (winnerIdx < 0 || handRank > maxRank) {
+            maxRank = handRank;
             maxCategory = handDescription;
             winner = player->getName();
             winnerIdx = i;
-         } else if (handScore == maxScore) {
+         } else if (handRank == maxRank) {
             tieWinner = player->getName();
             tieWinnerIdx = i;
          }
-         Logger::trace("current maxScore: " + to_string(maxScore));
+         Logger::trace(
+             "current maxRank: " + to_string(maxRank.getValue())
+         );
          Logger::trace("current maxCategory: " + maxCategory);
          Logger::trace("current winner: " + winner);
          Logger::trace("current winnerIdx: " + to_string(winnerIdx));
@@ -333,6 +564,10 @@ multimap<int, PokerPlayer::Outcome> PokerEngine::determineWinners()
       }
    }
 
+   ///< With every player folded, the pot goes to the last one standing
+   if (winnerIdx < 0) {
+      winnerIdx = lastFolded;
+   }
    if (winnerIdx >= 0) {
       winners.emplace(winnerIdx, outcomes.at(winnerIdx));
    }
@@ -413,6 +648,177 @@ void PokerEngine::printResults(multimap<int, PokerPlayer::Outcome> winners)
    Logger::console("Winning Pot is: " + cPot);
 }
 
+int PokerEngine::getSeat(const PokerPlayerPtr &player) const
+{
+   auto itr = find(players.begin(), players.end(), player);
+   return itr == players.end() ? -1 : static_cast<int>(itr - players.begin());
+}
+
+void PokerEngine::recordShowdown()
+{
+   auto winners = determineWinners();
+   for (auto &[index, outcome] : winners) {
+      recorder->win(index, pot / winners.size(), outcome.playerRank);
+   }
+   recorder->endHand();
+}
+
+multimap<int, PokerPlayer::Outcome> PokerEngine::payWinners()
+{
+   auto winners = determineWinners();
+   for (auto &[index, outcome] : winners) {
+      players[index]->collect(pot / winners.size());
+   }
+   return winners;
+}
+
+void PokerEngine::abandon()
+{
+   if (!isPlaying()) {
+      return;
+   }
+   Logger::debug("Abandoning a hand that is waiting for a decision.");
+   game = Task<>();
+   if (recorder) {
+      recorder->abortHand();
+   }
+   for (auto &player : players) {
+      player->reset(); ///< Forgets the questions the hand asked
+   }
+}
+
+PokerEngine::Turn PokerEngine::advance()
+{
+   while (!acting) {
+      switch (phase) {
+         case ANTE:
+            Logger::debug("Starting Game...");
+            ++hands;
+            if (recorder) {
+               int seats = static_cast<int>(players.size());
+               recorder->beginHand(hands, seats, ante, getDealer());
+            }
+            anteUp();
+            phase = DEAL;
+            break;
+         case DEAL:
+            dealCards();
+            advanceRound();
+            phase = BETTING;
+            break;
+         case BETTING:
+         case DRAWING:
+            ///< The next seat still in the round takes its turn, going
+            ///< round the table from the dealer's left
+            for (++position; position < static_cast<int>(players.size());
+                 ++position) {
+               currentPlayerIndex =
+                   (getDealer() + position + 1) % players.size();
+               auto state = players[currentPlayerIndex]->getState();
+               if (phase == BETTING ? state == PokerPlayer::Status::ACTIVE
+                                    : state != PokerPlayer::Status::FOLDED) {
+                  acting = true;
+                  return getTurn();
+               }
+            }
+            currentPlayerIndex = -1;
+            position = -1;
+            if (phase == DRAWING) {
+               advanceRound();
+               phase = BETTING;
+            } else {
+               phase = currentRound == 1 ? DRAWING : SHOWDOWN;
+            }
+            break;
+         case SHOWDOWN:
+            if (recorder) {
+               recordShowdown();
+            }
+            phase = OVER;
+            break;
+         case OVER:
+            return Turn();
+      }
+   }
+   return getTurn();
+}
+
+PokerEngine::Turn PokerEngine::getTurn() const
+{
+   Turn turn;
+   if (!acting) {
+      return turn;
+   }
+   const auto &player = players.at(currentPlayerIndex);
+   turn.phase = phase;
+   turn.seat = currentPlayerIndex;
+   turn.call = blind;
+   turn.balance = player->getBalance();
+   if (phase == DRAWING) {
+      turn.legal = 1u << DRAW;
+      turn.cards = player->show().playerHand->size();
+      return turn;
+   }
+   turn.legal = 1u << FOLD;
+   if (turn.balance >= blind) {
+      turn.legal |= 1u << CALL;
+   }
+   if (turn.balance > blind) {
+      turn.legal |= 1u << RAISE;
+   }
+   if (turn.balance > 0) {
+      turn.legal |= 1u << ALL_IN;
+   }
+   return turn;
+}
+
+void PokerEngine::apply(const Action &action)
+{
+   Turn turn = getTurn();
+   if (turn.phase == OVER || !turn.allows(action.move)) {
+      throw invalid_argument("That move is not allowed now.");
+   }
+   auto player = players.at(turn.seat);
+   if (action.move == DRAW) {
+      vector<int> discardIdxs = action.discards;
+      sort(discardIdxs.begin(), discardIdxs.end());
+      if (adjacent_find(discardIdxs.begin(), discardIdxs.end()) !=
+              discardIdxs.end() ||
+          (!discardIdxs.empty() &&
+           (discardIdxs.front() < 0 || discardIdxs.back() >= turn.cards))) {
+         throw invalid_argument("Discards must be distinct cards in the hand.");
+      }
+      handleDraw(player, action.discards);
+      return;
+   }
+
+   double amount = 0;
+   switch (action.move) {
+      case CALL:
+         amount = turn.call;
+         player->bet(amount);
+         player->call(amount);
+         break;
+      case RAISE:
+         if (action.amount <= turn.call || action.amount > turn.balance) {
+            throw invalid_argument("A raise must beat the blind and be paid.");
+         }
+         amount = action.amount;
+         player->bet(amount);
+         player->raise(amount);
+         break;
+      case ALL_IN:
+         amount = turn.balance;
+         player->bet(amount);
+         player->allIn(amount);
+         break;
+      default:
+         player->fold();
+         break;
+   }
+   handleBet(player, amount);
+}
+
 PlayerList PokerEngine::getPlayersByState(PokerPlayer::Status state) const
 {
    PlayerList result;
@@ -424,18 +830,27 @@ PlayerList PokerEngine::getPlayersByState(PokerPlayer::Status state) const
    return result;
 }
 
+shared_ptr<Card> PokerEngine::dealCard()
+{
+   auto card = deck->deal();
+   cardsDealt += card != nullptr;
+   return card;
+}
+
 void PokerEngine::shuffleDeck()
 {
-   Logger::info("Shuffling " + to_string(deck->size()) + " card deck...\n");
+   if (dealOrder) {
+      size_t next = min(cardsDealt, dealOrder->size());
+      deck->stack(dealOrder->data() + next, dealOrder->size() - next);
+      return;
+   }
+   Logger::debug("Shuffling " + to_string(deck->size()) + " card deck...");
    deck->shuffle();
 }
 
 void PokerEngine::recycleDiscards()
 {
    Logger::debug("Recycling " + to_string(discards->size()) + " discards.");
-   for (int i = 0; i < discards->size(); i++) {
-      deck->add(discards->get(i));
-      discards->remove(discards->get(i));
-   }
+   deck->recycle(*discards);
    shuffleDeck();
 }
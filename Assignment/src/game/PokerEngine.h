@@ -6,11 +6,16 @@
 #define ENGINE_H
 
 #include "../../utils/Logger.h"
+#include "../../utils/Task.h"
+#include "history/HistoryWriter.h"
 #include "player/PokerPlayer.h"
 #include "resources/Deck.h"
 #include "resources/PokerHand.h"
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <optional>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -19,13 +24,92 @@
  * @brief Manages a 5-card draw poker game with multiple players.
  *
  * Coordinates the game logic including dealing, betting, and
- * determining winners.
+ * determining winners. A headless engine never prompts and sends its
+ * console output, and that of its players, to a chosen stream or nowhere,
+ * so AI players can play hand after hand unattended. An attached
+ * HistoryWriter records every hand it plays as binary events, and a
+ * recorded deal order can stand in for the shuffle to replay a hand.
+ *
+ * A hand is an explicit sequence of phases: ante, deal, betting, drawing,
+ * betting again and showdown. step() runs the hand up to the next player
+ * who must act and names the actions that player may take; step(action)
+ * takes the action and runs on to the next. A scheduler can interleave any
+ * number of tables this way on one thread, and a solver can enumerate
+ * legal actions without playing through players.
+ *
+ * play() drives the same phases with a coroutine that awaits each player's
+ * own decision. When a decision is not ready, the hand is suspended and
+ * the engine's thread is free until the answer arrives and resumes it.
+ *
+ * Cards are dealt and turns taken starting left of the dealer. A session
+ * plays hand after hand at the same table, paying each pot, moving the
+ * dealer one seat on and reusing the engine's decks and the players' hands
+ * rather than building new ones.
  */
 class PokerEngine
 {
  public:
    static constexpr double DEFAULT_ANTE = 10.0; ///< Default ante value.
 
+   /**
+    * @brief The phases of a hand, in the order they are played.
+    */
+   enum Phase
+   {
+      ANTE,     ///< Collect the ante from every player
+      DEAL,     ///< Deal five cards to every player who paid
+      BETTING,  ///< Each active player bets once, in seat order
+      DRAWING,  ///< Each player still in discards and draws, in seat order
+      SHOWDOWN, ///< Name the winners
+      OVER      ///< The hand is finished
+   };
+
+   /**
+    * @brief The actions a player can take on their turn.
+    */
+   enum Move
+   {
+      FOLD,   ///< Give up the hand
+      CALL,   ///< Bet the blind
+      RAISE,  ///< Bet more than the blind
+      ALL_IN, ///< Bet the whole balance
+      DRAW    ///< Replace some cards, possibly none
+   };
+
+   /**
+    * @brief A player's choice on their turn.
+    */
+   struct Action
+   {
+      Move move = FOLD;            ///< What the player does
+      double amount = 0;           ///< RAISE: the whole bet
+      std::vector<int> discards{}; ///< DRAW: hand indices to replace
+   };
+
+   /**
+    * @brief Who must act next, and what they may do.
+    */
+   struct Turn
+   {
+      Phase phase = OVER;  ///< BETTING or DRAWING, or OVER after the hand
+      int seat = -1;       ///< The player who must act, or -1
+      unsigned legal = 0;  ///< One bit per allowed Move
+      double call = 0;     ///< The blind, which CALL bets
+      double balance = 0;  ///< The most the player can bet
+      int cards = 0;       ///< Cards the player may discard
+
+      /**
+       * @brief Returns whether a move is allowed.
+       *
+       * @param move The move.
+       * @return true if the player may make it.
+       */
+      bool allows(Move move) const
+      {
+         return (legal >> move) & 1u;
+      }
+   };
+
    /**
     * @brief Format double as currency.
     *
@@ -62,9 +146,70 @@ class PokerEngine
     * @brief Starts the poker game.
     *
     * Manages the game flow, including dealing, betting rounds, and showdown.
+    * Returns when the hand is over, or when it is suspended waiting for a
+    * player's decision; isPlaying() tells which.
     */
    virtual void startGame();
 
+   /**
+    * @brief Plays one hand as a coroutine.
+    * @details The coroutine runs until a player's decision is not ready,
+    * and the answer resumes it on the answering thread. While suspended,
+    * the engine gives the thread its console back.
+    *
+    * @return Task<> The hand, ready when it is over.
+    */
+   Task<> play();
+
+   /**
+    * @brief Plays hands back to back at this table.
+    * @details Each hand starts from reset(), pays the pot to its winners
+    * and passes the deal to the next seat. The session ends after the
+    * given number of hands, or once fewer than two players can pay the
+    * ante. Like play(), it is suspended while a hand waits for a decision;
+    * destroying it unfinished abandons that hand.
+    *
+    * @param count The most hands to play.
+    * @return Task<int> The number of hands played, ready when it is over.
+    */
+   Task<int> playSession(int count);
+
+   /**
+    * @brief Returns whether a started hand is waiting for a decision.
+    *
+    * @return true if the hand is suspended.
+    */
+   bool isPlaying() const;
+
+   /**
+    * @brief Runs the hand up to the next player who must act.
+    * @details Plays the phases that need no decision, such as the ante,
+    * the deal and the showdown. Asking again before an action is taken
+    * returns the same turn. reset() readies the next hand.
+    *
+    * @return Turn The player to act and their legal moves, or an OVER turn.
+    */
+   Turn step();
+
+   /**
+    * @brief Takes the acting player's action and runs on to the next turn.
+    * @details CALL bets the blind and ALL_IN the whole balance, whatever
+    * the amount given. The player's own bet() and discard() are not asked.
+    *
+    * @param action The action of the player whose turn it is.
+    * @return Turn The next player to act, or an OVER turn.
+    * @throws std::invalid_argument if the action is not legal.
+    * @throws std::logic_error if play() is driving the hand.
+    */
+   Turn step(const Action &action);
+
+   /**
+    * @brief Returns the phase the hand is in.
+    *
+    * @return Phase The phase.
+    */
+   Phase getPhase() const;
+
    /**
     * @brief Returns a list of outcomes.
     * @param output Whether to output the results.
@@ -73,11 +218,81 @@ class PokerEngine
 
    /**
     * @brief Adds a player to the game.
+    * @details Headless engines refuse players who read their decisions
+    * from standard input, such as local human players.
     *
     * @param player A shared pointer to a PokerPlayer.
     */
    void addPlayer(std::shared_ptr<PokerPlayer> player);
 
+   /**
+    * @brief Unseats every player.
+    * @details Players hold their engine, so this also releases an engine
+    * that is no longer needed.
+    */
+   void clearPlayers();
+
+   /**
+    * @brief Returns the cards, pot and player states to a fresh hand.
+    * @details Players keep their balances, so a headless engine can play
+    * any number of hands back to back.
+    */
+   void reset();
+
+   /**
+    * @brief Turns headless mode on or off.
+    *
+    * @param headless Whether to skip prompts and redirect console output.
+    * @param output Where console output goes while headless, or nullptr
+    * to discard it.
+    */
+   void setHeadless(bool headless, std::ostream *output = nullptr);
+
+   /**
+    * @brief Records every following hand, or stops recording.
+    * @details Each startGame() records one hand, ending with the winners'
+    * shares of the pot as determineWinners() names them.
+    *
+    * @param recorder The history to append to, or nullptr.
+    */
+   void setRecorder(std::shared_ptr<HistoryWriter> recorder);
+
+   /**
+    * @brief Deals the given cards in order instead of shuffling.
+    * @details Every shuffle of the hand stacks the cards not yet dealt on
+    * top of the deck, so a recorded hand is dealt again exactly. reset()
+    * starts again from the first card.
+    *
+    * @param cards The cards in dealing order, or nullptr to shuffle. They
+    * are not copied, so they must outlive the hand.
+    */
+   void setDealOrder(const std::vector<CardId> *cards);
+
+   /**
+    * @brief Returns whether the engine is headless.
+    *
+    * @return true if the engine never prompts.
+    */
+   bool isHeadless() const;
+
+   /**
+    * @brief Determines the winner(s) of the game.
+    * @details Folded players cannot win; a tie names a second winner. If
+    * every player folded, the last to fold takes the pot, so no hand
+    * leaves its chips unpaid.
+    *
+    * @return std::multimap<int index, PokerPlayer::Outcome>
+    */
+   std::multimap<int, PokerPlayer::Outcome> determineWinners();
+
+   /**
+    * @brief Pays the pot to the winners, split evenly on a tie.
+    *
+    * @return std::multimap<int index, PokerPlayer::Outcome> The winners
+    * paid, as determineWinners() names them.
+    */
+   std::multimap<int, PokerPlayer::Outcome> payWinners();
+
    /**
     * @brief Returns a pointer to the active player.
     *
@@ -99,6 +314,31 @@ class PokerEngine
     */
    double getPot() const;
 
+   /**
+    * @brief Returns how many seated players are still in the hand.
+    *
+    * @return int The players who have not folded.
+    */
+   int getContenders() const;
+
+   /**
+    * @brief Seats the dealer.
+    * @details The next hand is dealt and bet starting from the seat after
+    * the dealer. Seats past the last wrap around the table.
+    *
+    * @param seat The dealer's seat.
+    */
+   void setDealer(int seat);
+
+   /**
+    * @brief Returns the dealer's seat.
+    * @details Until a dealer is seated it is the last seat, so seat 0 is
+    * dealt first.
+    *
+    * @return int The seat, or -1 if no one is seated.
+    */
+   int getDealer() const;
+
    /**
     * @brief Sets the ante value for the game.
     *
@@ -117,16 +357,6 @@ class PokerEngine
     */
    virtual void dealCards();
 
-   /**
-    * @brief Executes a round of betting.
-    */
-   virtual void bettingRound();
-
-   /**
-    * @brief Manages the drawing phase where players can exchange cards.
-    */
-   virtual void drawingRound();
-
    /**
     * @brief Resets the game state for a new round.
     */
@@ -152,14 +382,33 @@ class PokerEngine
    virtual void prompt(std::string message);
 
  private:
+   /**
+    * @brief Awaits a player's decision, giving the console back while the
+    * hand is suspended.
+    */
+   template <typename T> struct Pending;
+
    int currentPlayerIndex{-1};                        ///< Current player index.
+   int position{-1};                                  ///< Turns from the dealer.
+   int dealer{-1};                                    ///< Dealer's seat.
+   int lastFolded{-1};                                ///< Last seat to fold.
    int currentRound{0};                               ///< Current round.
+   Phase phase{ANTE};                                 ///< Current phase.
+   bool acting{false};                                ///< Awaiting action.
    double ante;                                       ///< Game ante.
    double pot;                                        ///< Game Pot.
-   double blind;                                      ///< Game blind.
+   double blind{0.0};                                 ///< Game blind.
+   bool headless{false};                              ///< Never prompt.
+   std::ostream *output{nullptr};                     ///< Headless output.
    std::vector<std::shared_ptr<PokerPlayer>> players; ///< Game players.
    std::shared_ptr<Deck> deck;                        ///< Game deck.
    std::shared_ptr<Deck> discards;                    ///< Discarded cards.
+   std::shared_ptr<HistoryWriter> recorder;           ///< Hand history.
+   std::uint64_t hands{0};                            ///< Hands started.
+   const std::vector<CardId> *dealOrder{nullptr};     ///< Replayed deal.
+   size_t cardsDealt{0};                              ///< Cards dealt.
+   Task<> game;                                       ///< Hand started.
+   std::optional<Logger::Redirect> redirect;          ///< Hand's console.
 
    /**
     * @brief Returns a string description of the given category.
@@ -172,22 +421,46 @@ class PokerEngine
     * @brief Handles the draw phase for a player.
     *
     * @param player The player to handle.
+    * @param discardIdxs The indices of the cards the player discards.
     */
-   virtual void handleDraw(std::shared_ptr<PokerPlayer> player);
+   virtual void handleDraw(
+       std::shared_ptr<PokerPlayer> player, std::vector<int> discardIdxs
+   );
 
    /**
-    * @brief Handles the bet phase for a player.
+    * @brief Handles the bet an active player has decided.
     *
     * @param player The player to handle.
+    * @param amount The amount the player bet.
     */
-   virtual void handleBet(std::shared_ptr<PokerPlayer> player);
+   virtual void handleBet(std::shared_ptr<PokerPlayer> player, double amount);
 
    /**
-    * @brief Determines the winner(s) of the game.
+    * @brief Abandons a suspended hand and the questions it was waiting on.
+    */
+   void abandon();
+
+   /**
+    * @brief Plays phases until a player must act or the hand is over.
     *
-    * @return std::multimap<int index, PokerPlayer::Outcome>
+    * @return Turn The player to act, or an OVER turn.
     */
-   std::multimap<int, PokerPlayer::Outcome> determineWinners();
+   Turn advance();
+
+   /**
+    * @brief Returns the turn of the current player.
+    *
+    * @return Turn The player's legal moves.
+    */
+   Turn getTurn() const;
+
+   /**
+    * @brief Applies a legal action to the current player.
+    *
+    * @param action The action.
+    * @throws std::invalid_argument if the action is not legal.
+    */
+   void apply(const Action &action);
 
    /**
     * @brief Prints the results of the game.
@@ -206,7 +479,27 @@ class PokerEngine
    getPlayersByState(PokerPlayer::Status state) const;
 
    /**
-    * @brief Shuffles the deck of cards.
+    * @brief Returns the seat of a player.
+    *
+    * @param player The player.
+    * @return int The player's index, or -1 if not seated.
+    */
+   int getSeat(const std::shared_ptr<PokerPlayer> &player) const;
+
+   /**
+    * @brief Records the winners' shares and ends the recorded hand.
+    */
+   void recordShowdown();
+
+   /**
+    * @brief Deals the top card of the deck.
+    *
+    * @return std::shared_ptr<Card> The card, or nullptr if the deck is empty.
+    */
+   std::shared_ptr<Card> dealCard();
+
+   /**
+    * @brief Shuffles the deck of cards, or stacks the replayed deal.
     */
    void shuffleDeck();
 
@@ -0,0 +1,195 @@
+/**
+ * @file src/game/analysis/DrawEquity.cpp
+ * @brief Implementation of the DrawEquity class.
+ */
+#include "DrawEquity.h"
+#include "../../../utils/Logger.h"
+#include "../../../utils/Random.h"
+#include "../resources/Deck.h"
+#include "../resources/HandEvaluator.h"
+#include <algorithm>
+#include <future>
+
+using namespace std;
+using HandPtr = shared_ptr<Hand>;
+
+namespace
+{
+constexpr long TIMED_BATCH = 256; ///< Samples between deadline checks
+} // namespace
+
+DrawEquity::DrawEquity(size_t threads)
+    : pool(make_unique<ThreadPool>(threads))
+{}
+
+size_t DrawEquity::getThreads() const
+{
+   return pool->size();
+}
+
+DrawTable::Outcome DrawEquity::distribution(
+    const shared_ptr<Hand> &hand, const vector<int> &discards
+)
+{
+   const auto &table = DrawTable::shared();
+   return table ? table->lookup(hand, discards) : DrawTable::Outcome();
+}
+
+bool DrawEquity::prepare(
+    const HandPtr &hand, const vector<int> &discards, int opponents,
+    const CardCollection &dead, Setup &setup
+)
+{
+   if (!hand || !hand->isValid()) {
+      Logger::warn("Equity needs a valid five card hand.");
+      return false;
+   }
+   if (opponents < 1 || opponents > MAX_OPPONENTS) {
+      Logger::warn(
+          "Equity needs 1 to 9 opponents, not " + to_string(opponents) + "."
+      );
+      return false;
+   }
+
+   setup.kept = hand->getMask();
+   for (int idx : discards) {
+      if (idx < 0 || idx >= static_cast<int>(hand->size())) {
+         Logger::warn("Discard index " + to_string(idx) + " is out of range.");
+         return false;
+      }
+      CardMask card = CardBits::toMask(hand->get(idx)->getId());
+      if (!(setup.kept & card)) {
+         Logger::warn("Discard index " + to_string(idx) + " is repeated.");
+         return false;
+      }
+      setup.kept &= ~card;
+   }
+   setup.draws = static_cast<int>(discards.size());
+   setup.opponents = opponents;
+
+   ///< Discarded cards stay out of play along with the dead ones
+   Deck deck;
+   deck.removeCards(hand->getMask() | dead.getMask());
+   setup.stubSize = static_cast<int>(deck.size());
+   for (int i = 0; i < setup.stubSize; ++i) {
+      setup.stub[i] = deck.get(i)->getId();
+   }
+   if (setup.draws + 5 * opponents > setup.stubSize) {
+      Logger::warn("Not enough live cards to deal every opponent.");
+      return false;
+   }
+   return true;
+}
+
+template <typename Generator>
+void DrawEquity::sample(
+    const Setup &setup, long samples, Generator &rng, Counts &counts
+)
+{
+   CardId ids[CardBits::DECK_SIZE];
+   copy(setup.stub, setup.stub + setup.stubSize, ids);
+   const int n = setup.stubSize;
+   const int needed = setup.draws + 5 * setup.opponents;
+
+   for (long s = 0; s < samples; ++s) {
+      ///< A partial Fisher-Yates shuffle deals the first needed cards
+      for (int i = 0; i < needed; ++i) {
+         swap(ids[i], ids[i + rng.below(n - i)]);
+      }
+      CardMask mask = setup.kept;
+      const CardId *next = ids;
+      for (int i = 0; i < setup.draws; ++i) {
+         mask |= CardBits::toMask(*next++);
+      }
+      uint16_t score = HandEvaluator::evaluate(mask);
+      uint16_t best = 0;
+      for (int p = 0; p < setup.opponents; ++p) {
+         CardMask other = 0;
+         for (int i = 0; i < 5; ++i) {
+            other |= CardBits::toMask(*next++);
+         }
+         best = max(best, HandEvaluator::evaluate(other));
+      }
+      if (score > best) {
+         ++counts.win;
+      } else if (score == best) {
+         ++counts.tie;
+      } else {
+         ++counts.loss;
+      }
+   }
+}
+
+DrawEquity::Result DrawEquity::finish(const Counts &counts)
+{
+   Result result;
+   result.samples = counts.win + counts.tie + counts.loss;
+   if (result.samples > 0) {
+      double total = static_cast<double>(result.samples);
+      result.win = counts.win / total;
+      result.tie = counts.tie / total;
+      result.loss = counts.loss / total;
+   }
+   return result;
+}
+
+DrawEquity::Result DrawEquity::calculate(
+    const HandPtr &hand, const vector<int> &discards, int opponents,
+    const CardCollection &dead, long samples, uint64_t seed
+)
+{
+   Setup setup;
+   if (samples <= 0 || !prepare(hand, discards, opponents, dead, setup)) {
+      return Result();
+   }
+
+   vector<future<Counts>> batches;
+   Xoshiro256 stream(seed);
+   for (long first = 0; first < samples; first += BATCH_SIZE) {
+      long size = min(BATCH_SIZE, samples - first);
+      batches.push_back(pool->submit([&setup, size, rng = stream]() mutable {
+         Counts counts;
+         sample(setup, size, rng, counts);
+         return counts;
+      }));
+      stream.jump();
+   }
+
+   Counts total;
+   for (auto &batch : batches) {
+      total += batch.get();
+   }
+   return finish(total);
+}
+
+DrawEquity::Result DrawEquity::calculate(
+    const HandPtr &hand, const vector<int> &discards, int opponents,
+    const CardCollection &dead, chrono::microseconds budget, uint64_t seed
+)
+{
+   Setup setup;
+   if (!prepare(hand, discards, opponents, dead, setup)) {
+      return Result();
+   }
+
+   auto deadline = chrono::steady_clock::now() + budget;
+   vector<future<Counts>> workers;
+   Xoshiro256 stream(seed);
+   for (size_t i = 0; i < pool->size(); ++i) {
+      auto task = [&setup, deadline, rng = stream]() mutable {
+         Counts counts;
+         do {
+            sample(setup, TIMED_BATCH, rng, counts);
+         } while (chrono::steady_clock::now() < deadline);
+         return counts;
+      };
+      workers.push_back(pool->submit(task));
+      stream.jump();
+   }
+
+   Counts total;
+   for (auto &worker : workers) {
+      total += worker.get();
+   }
+   return finish(total);
+}
@@ -0,0 +1,177 @@
+/**
+ * @file src/game/analysis/DrawEquity.h
+ * @brief Monte Carlo win, tie and loss odds for a five card draw.
+ */
+#ifndef DRAW_EQUITY_H
+#define DRAW_EQUITY_H
+
+#include "../../../utils/ThreadPool.h"
+#include "../resources/CardBits.h"
+#include "../resources/CardCollection.h"
+#include "../resources/Hand.h"
+#include "DrawTable.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class DrawEquity
+ * @brief Estimates how often a hand wins after drawing replacements.
+ *
+ * Each sample deals the replacements for the discarded cards and five
+ * cards to every opponent from the cards that are neither in the hand nor
+ * dead, then compares the final hands by PokerHand score. Opponents are
+ * modelled as standing on five random cards. Samples are split into
+ * fixed size batches, each drawing from its own generator stream, so a
+ * sample budget gives the same result for a seed on any number of threads.
+ *
+ * Odds against opponents depend on the opponents' cards, which no table
+ * holds, so they are always sampled. How the drawing hand itself ends up
+ * is a lookup in the installed DrawTable, through distribution().
+ */
+class DrawEquity
+{
+ public:
+   static constexpr int MAX_OPPONENTS = 9;  ///< Ten players share 52 cards
+   static constexpr long BATCH_SIZE = 4096; ///< Samples per pool task
+
+   /**
+    * @brief The estimated odds and how many samples produced them.
+    */
+   struct Result
+   {
+      double win = 0;   ///< Beats every opponent
+      double tie = 0;   ///< Splits the pot with the best opponents
+      double loss = 0;  ///< Beaten by at least one opponent
+      long samples = 0; ///< Zero if the request was invalid
+   };
+
+   /**
+    * @brief Constructs a calculator with its own thread pool.
+    * @param threads The number of worker threads.
+    */
+   explicit DrawEquity(
+       size_t threads = std::max(1u, std::thread::hardware_concurrency())
+   );
+
+   /**
+    * @brief Estimates the odds from a fixed number of samples.
+    *
+    * @param hand The five card hand.
+    * @param discards Indices into the hand, as from PokerPlayer::discard.
+    * @param opponents The number of opponents, 1 to MAX_OPPONENTS.
+    * @param dead Known cards that cannot be dealt.
+    * @param samples The number of samples.
+    * @param seed Seeds the generator streams.
+    * @return Result The odds, or zero samples if the request was invalid.
+    */
+   Result calculate(
+       const std::shared_ptr<Hand> &hand, const std::vector<int> &discards,
+       int opponents, const CardCollection &dead, long samples,
+       std::uint64_t seed = 0
+   );
+
+   /**
+    * @brief Estimates the odds from as many samples as fit a time budget.
+    *
+    * @param hand The five card hand.
+    * @param discards Indices into the hand, as from PokerPlayer::discard.
+    * @param opponents The number of opponents, 1 to MAX_OPPONENTS.
+    * @param dead Known cards that cannot be dealt.
+    * @param budget How long to keep sampling.
+    * @param seed Seeds the generator streams.
+    * @return Result The odds, or zero samples if the request was invalid.
+    */
+   Result calculate(
+       const std::shared_ptr<Hand> &hand, const std::vector<int> &discards,
+       int opponents, const CardCollection &dead,
+       std::chrono::microseconds budget, std::uint64_t seed = 0
+   );
+
+   /**
+    * @brief Looks up how a discard's final hands fall into categories.
+    * @details Exact over every draw from the 47 unseen cards, as read from
+    * DrawTable::shared(). Dead cards are not taken into account.
+    *
+    * @param hand The five card hand.
+    * @param discards Indices into the hand, as from PokerPlayer::discard.
+    * @return DrawTable::Outcome The outcomes, or zero draws if no table is
+    * installed, it lacks the hand, or the request is invalid.
+    */
+   static DrawTable::Outcome distribution(
+       const std::shared_ptr<Hand> &hand, const std::vector<int> &discards
+   );
+
+   /**
+    * @brief Returns the number of worker threads.
+    */
+   size_t getThreads() const;
+
+ private:
+   /**
+    * @brief The cards a sample starts from.
+    */
+   struct Setup
+   {
+      CardMask kept = 0;                       ///< Cards the hand keeps
+      int draws = 0;                           ///< Replacements to deal
+      int opponents = 0;                       ///< Opponents to deal to
+      int stubSize = 0;                        ///< Cards left to deal from
+      CardId stub[CardBits::DECK_SIZE] = {0}; ///< Cards left to deal from
+   };
+
+   /**
+    * @brief Win, tie and loss counts of one batch.
+    */
+   struct Counts
+   {
+      long win = 0;
+      long tie = 0;
+      long loss = 0;
+
+      /**
+       * @brief Adds the counts of another batch.
+       */
+      Counts &operator+=(const Counts &other)
+      {
+         win += other.win;
+         tie += other.tie;
+         loss += other.loss;
+         return *this;
+      }
+   };
+
+   /**
+    * @brief Validates a request and builds its setup.
+    *
+    * @return true if the request can be sampled.
+    */
+   static bool prepare(
+       const std::shared_ptr<Hand> &hand, const std::vector<int> &discards,
+       int opponents, const CardCollection &dead, Setup &setup
+   );
+
+   /**
+    * @brief Runs samples with one generator stream.
+    *
+    * @tparam Generator A generator with a below(n) member.
+    * @param setup The starting cards.
+    * @param samples The number of samples.
+    * @param rng The generator stream.
+    * @param counts Accumulates the outcomes.
+    */
+   template <typename Generator>
+   static void sample(
+       const Setup &setup, long samples, Generator &rng, Counts &counts
+   );
+
+   /**
+    * @brief Converts counts into odds.
+    */
+   static Result finish(const Counts &counts);
+
+   std::unique_ptr<ThreadPool> pool; ///< Workers that run the batches
+};
+
+#endif // DRAW_EQUITY_H
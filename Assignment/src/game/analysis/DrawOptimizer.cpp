@@ -0,0 +1,147 @@
+/**
+ * @file src/game/analysis/DrawOptimizer.cpp
+ * @brief Implementation of the DrawOptimizer class.
+ */
+#include "DrawOptimizer.h"
+#include "../../../utils/Logger.h"
+#include "../resources/Card.h"
+#include "../resources/HandEvaluator.h"
+#include <bit>
+
+using namespace std;
+
+/**
+ * @struct DrawOptimizer::Tables
+ * @brief Rank sums of the five card hands holding each set of cards.
+ *
+ * sums[k] holds one entry per k card set, indexed by the set's colex rank,
+ * CardBits::rankCombination. Since colex order is the numeric order of the
+ * sets' CardMasks, every level is built by walking the masks with k bits in
+ * increasing order.
+ */
+struct DrawOptimizer::Tables
+{
+   static constexpr int DECK_SIZE = CardBits::DECK_SIZE;
+
+   std::array<std::vector<std::uint64_t>, HAND_SIZE> sums; ///< By set size
+
+   /**
+    * @brief Builds the sums from every five card hand.
+    */
+   Tables()
+   {
+      for (int k = 0; k < HAND_SIZE; ++k) {
+         sums[k].assign(CardBits::CHOOSE[k][DECK_SIZE], 0);
+      }
+
+      ///< Each hand adds its rank to the five sets it holds one card fewer
+      ///< than, and each set's sum passes down the same way; a set of k
+      ///< cards lies in 5 - k sets one card larger of every hand holding it
+      for (int k = HAND_SIZE - 1; k >= 0; --k) {
+         const CardMask end = CardMask{1} << DECK_SIZE;
+         uint32_t index = 0;
+         for (CardMask set = (CardMask{1} << (k + 1)) - 1; set < end;
+              set = CardBits::nextCombination(set), ++index) {
+            uint64_t total = k == HAND_SIZE - 1 ? HandEvaluator::evaluate(set)
+                                                : sums[k + 1][index];
+            for (CardMask rest = set; rest;) {
+               CardMask card = rest & -rest;
+               rest ^= card;
+               sums[k][CardBits::rankCombination(set ^ card)] += total;
+            }
+         }
+         for (auto &sum : sums[k]) {
+            sum /= HAND_SIZE - k;
+         }
+      }
+   }
+};
+
+const DrawOptimizer::Tables &DrawOptimizer::tables()
+{
+   static const Tables instance;
+   return instance;
+}
+
+array<double, DrawOptimizer::PATTERNS> DrawOptimizer::score(const CardId *ids)
+{
+   const Tables &t = tables();
+
+   ///< Rank sums of the hands holding each subset of the hand
+   array<int64_t, PATTERNS> held;
+   CardMask hand = 0;
+   for (int i = 0; i < HAND_SIZE; ++i) {
+      hand |= CardBits::toMask(ids[i]);
+   }
+   held[PATTERNS - 1] = HandEvaluator::evaluate(hand);
+   for (unsigned subset = 0; subset < PATTERNS - 1; ++subset) {
+      CardMask set = 0;
+      for (int i = 0; i < HAND_SIZE; ++i) {
+         if (subset >> i & 1) {
+            set |= CardBits::toMask(ids[i]);
+         }
+      }
+      held[subset] = t.sums[popcount(subset)][CardBits::rankCombination(set)];
+   }
+
+   ///< Keep the rest, and leave out each discarded card by
+   ///< inclusion-exclusion
+   array<double, PATTERNS> scores;
+   for (unsigned pattern = 0; pattern < PATTERNS; ++pattern) {
+      unsigned kept = (PATTERNS - 1) & ~pattern;
+      int64_t total = 0;
+      for (unsigned also = pattern;; also = (also - 1) & pattern) {
+         total += popcount(also) % 2 ? -held[kept | also] : held[kept | also];
+         if (also == 0) {
+            break;
+         }
+      }
+      int draws = popcount(pattern);
+      scores[pattern] = static_cast<double>(total) /
+                        CardBits::CHOOSE[draws][Tables::DECK_SIZE - HAND_SIZE];
+   }
+   return scores;
+}
+
+DrawOptimizer::Choice DrawOptimizer::best(const CardId *ids)
+{
+   return best(score(ids));
+}
+
+DrawOptimizer::Choice
+DrawOptimizer::best(const array<double, PATTERNS> &scores)
+{
+   Choice choice{STAND_PAT, scores[STAND_PAT]};
+   for (unsigned pattern = 1; pattern < PATTERNS; ++pattern) {
+      if (scores[pattern] > choice.expected ||
+          (scores[pattern] == choice.expected &&
+           popcount(pattern) < popcount(choice.pattern))) {
+         choice = {pattern, scores[pattern]};
+      }
+   }
+   return choice;
+}
+
+vector<int> DrawOptimizer::discard(const shared_ptr<Hand> &hand)
+{
+   if (!hand || !hand->isValid() || hand->size() != HAND_SIZE) {
+      Logger::warn("The draw optimizer needs a valid five card hand.");
+      return {};
+   }
+   CardId ids[HAND_SIZE];
+   for (int i = 0; i < HAND_SIZE; ++i) {
+      ids[i] = hand->get(i)->getId();
+   }
+   return toIndices(best(ids).pattern);
+}
+
+vector<int> DrawOptimizer::toIndices(unsigned pattern)
+{
+   vector<int> idxs;
+   for (int i = 0; i < HAND_SIZE; ++i) {
+      if (pattern >> i & 1) {
+         idxs.push_back(i);
+      }
+   }
+   return idxs;
+}
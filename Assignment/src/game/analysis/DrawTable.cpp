@@ -0,0 +1,378 @@
+/**
+ * @file src/game/analysis/DrawTable.cpp
+ * @brief Implementation of the DrawTable class.
+ */
+#include "DrawTable.h"
+#include "../../../utils/Logger.h"
+#include "../resources/Card.h"
+#include "../resources/HandEvaluator.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <fcntl.h>
+#include <fstream>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace
+{
+using Counts = array<uint32_t, DrawTable::CATEGORIES>;
+
+/**
+ * @brief Category counts of the five card hands holding each set of cards.
+ *
+ * Laid out as DrawOptimizer lays out its rank sums: one entry per set of at
+ * most four cards, by set size and colex rank.
+ */
+struct CategoryCounts
+{
+   static constexpr int HAND_SIZE = DrawOptimizer::HAND_SIZE;
+   static constexpr int DECK_SIZE = CardBits::DECK_SIZE;
+
+   array<vector<Counts>, HAND_SIZE> counts; ///< By set size
+
+   /**
+    * @brief Counts every five card hand once into each set it holds.
+    */
+   CategoryCounts()
+   {
+      for (int k = 0; k < HAND_SIZE; ++k) {
+         counts[k].assign(CardBits::CHOOSE[k][DECK_SIZE], Counts{});
+      }
+
+      ///< As with the rank sums, each set passes its counts to the sets
+      ///< one card smaller, each of which hears from 5 - k larger sets
+      const CardMask end = CardMask{1} << DECK_SIZE;
+      for (int k = HAND_SIZE - 1; k >= 0; --k) {
+         uint32_t index = 0;
+         for (CardMask set = (CardMask{1} << (k + 1)) - 1; set < end;
+              set = CardBits::nextCombination(set), ++index) {
+            Counts total{};
+            if (k == HAND_SIZE - 1) {
+               uint16_t score = HandEvaluator::evaluate(set);
+               total[HandEvaluator::getCategory(score)] = 1;
+            } else {
+               total = counts[k + 1][index];
+            }
+            for (CardMask rest = set; rest;) {
+               CardMask card = rest & -rest;
+               rest ^= card;
+               Counts &into = counts[k][CardBits::rankCombination(set ^ card)];
+               for (int c = 0; c < DrawTable::CATEGORIES; ++c) {
+                  into[c] += total[c];
+               }
+            }
+         }
+         for (auto &entry : counts[k]) {
+            for (auto &count : entry) {
+               count /= HAND_SIZE - k;
+            }
+         }
+      }
+   }
+};
+
+/**
+ * @brief Appends an integer, little-endian.
+ */
+void put(vector<unsigned char> &out, uint64_t value, int bytes)
+{
+   for (int i = 0; i < bytes; ++i) {
+      out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+   }
+}
+
+/**
+ * @brief Reads a little-endian integer.
+ */
+uint64_t get(const unsigned char *in, int bytes)
+{
+   uint64_t value = 0;
+   for (int i = 0; i < bytes; ++i) {
+      value |= uint64_t{in[i]} << (8 * i);
+   }
+   return value;
+}
+
+mutex sharedLock;                        ///< Guards the installed table
+string sharedPath;                       ///< The installed table file
+shared_ptr<const DrawTable> sharedTable; ///< Mapped on first use
+bool sharedTried = false;                ///< Whether the file was tried
+atomic<uint64_t> sharedVersion = 0;      ///< Installs so far
+} // namespace
+
+DrawTable::~DrawTable()
+{
+   close();
+}
+
+bool DrawTable::generate(const string &path, uint32_t classes)
+{
+   classes = min(classes, SuitIsomorphism::CLASS_COUNT);
+   ofstream file(path, ios::binary | ios::trunc);
+   if (!file) {
+      Logger::warn("Cannot write draw table " + path + ".");
+      return false;
+   }
+   vector<unsigned char> out(MAGIC.begin(), MAGIC.end());
+   put(out, VERSION, 2);
+   put(out, CATEGORIES, 2);
+   put(out, classes, 4);
+   put(out, PATTERNS, 4);
+   file.write(reinterpret_cast<const char *>(out.data()), out.size());
+
+   const CategoryCounts table;
+   for (uint32_t index = 0; index < classes && file; ++index) {
+      CardMask hand = SuitIsomorphism::unindex(index);
+      CardId ids[DrawOptimizer::HAND_SIZE];
+      for (CardMask rest = hand; auto &id : ids) {
+         id = CardBits::popLowest(rest);
+      }
+
+      ///< Counts of the hands holding each subset of the hand
+      array<Counts, PATTERNS> held;
+      held[PATTERNS - 1] = Counts{};
+      held[PATTERNS - 1]
+          [HandEvaluator::getCategory(HandEvaluator::evaluate(hand))] = 1;
+      for (unsigned subset = 0; subset < PATTERNS - 1; ++subset) {
+         CardMask set = 0;
+         for (int i = 0; i < DrawOptimizer::HAND_SIZE; ++i) {
+            if (subset >> i & 1) {
+               set |= CardBits::toMask(ids[i]);
+            }
+         }
+         held[subset] =
+             table.counts[popcount(subset)][CardBits::rankCombination(set)];
+      }
+
+      auto scores = DrawOptimizer::score(ids);
+      out.clear();
+      for (double score : scores) {
+         put(out, bit_cast<uint64_t>(score), 8);
+      }
+      for (unsigned pattern = 0; pattern < PATTERNS; ++pattern) {
+         unsigned kept = (PATTERNS - 1) & ~pattern;
+         array<int64_t, CATEGORIES> total{};
+         for (unsigned also = pattern;; also = (also - 1) & pattern) {
+            int sign = popcount(also) % 2 ? -1 : 1;
+            for (int c = 0; c < CATEGORIES; ++c) {
+               total[c] += sign * int64_t{held[kept | also][c]};
+            }
+            if (also == 0) {
+               break;
+            }
+         }
+         for (int64_t count : total) {
+            put(out, static_cast<uint64_t>(count), 4);
+         }
+      }
+      file.write(reinterpret_cast<const char *>(out.data()), out.size());
+   }
+   if (!file) {
+      Logger::warn("Failed writing draw table " + path + ".");
+      return false;
+   }
+   return true;
+}
+
+bool DrawTable::open(const string &path)
+{
+   close();
+   int fd = ::open(path.c_str(), O_RDONLY);
+   if (fd < 0) {
+      Logger::warn("Cannot open draw table " + path + ".");
+      return false;
+   }
+   struct stat info;
+   void *mapped = MAP_FAILED;
+   if (fstat(fd, &info) == 0 && info.st_size >= HEADER_SIZE) {
+      mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   }
+   ::close(fd); ///< The mapping outlives the descriptor
+   if (mapped == MAP_FAILED) {
+      Logger::warn(path + " is not a draw table.");
+      return false;
+   }
+   data = static_cast<const unsigned char *>(mapped);
+   length = static_cast<size_t>(info.st_size);
+
+   uint32_t count = static_cast<uint32_t>(get(data + 8, 4));
+   bool matches =
+       equal(MAGIC.begin(), MAGIC.end(), data) &&
+       get(data + 4, 2) == VERSION && get(data + 6, 2) == CATEGORIES &&
+       get(data + 12, 4) == PATTERNS && count <= SuitIsomorphism::CLASS_COUNT &&
+       length == HEADER_SIZE + size_t{count} * CLASS_SIZE;
+   if (!matches) {
+      Logger::warn(path + " is not a current draw table.");
+      close();
+      return false;
+   }
+   classes = count;
+
+   ///< Lookups land on scattered classes, so reading ahead only wastes I/O
+   madvise(const_cast<unsigned char *>(data), length, MADV_RANDOM);
+   return true;
+}
+
+void DrawTable::close()
+{
+   if (data) {
+      munmap(const_cast<unsigned char *>(data), length);
+   }
+   data = nullptr;
+   length = 0;
+   classes = 0;
+}
+
+bool DrawTable::isOpen() const
+{
+   return data != nullptr;
+}
+
+uint32_t DrawTable::getClassCount() const
+{
+   return classes;
+}
+
+const unsigned char *
+DrawTable::locate(const CardId *ids, array<unsigned, 5> &positions) const
+{
+   CardMask hand = 0;
+   for (int i = 0; i < DrawOptimizer::HAND_SIZE; ++i) {
+      if (ids[i] >= CardBits::DECK_SIZE) {
+         return nullptr;
+      }
+      hand |= CardBits::toMask(ids[i]);
+   }
+   uint32_t index = SuitIsomorphism::index(hand);
+   if (index >= classes) {
+      return nullptr;
+   }
+   auto canonical = SuitIsomorphism::canonicalize(hand);
+   for (int i = 0; i < DrawOptimizer::HAND_SIZE; ++i) {
+      CardMask card =
+          SuitIsomorphism::relabel(CardBits::toMask(ids[i]), canonical.suits);
+      positions[i] = CardBits::count(canonical.hand & (card - 1));
+   }
+   return data + HEADER_SIZE + size_t{index} * CLASS_SIZE;
+}
+
+DrawTable::Outcome
+DrawTable::decode(const unsigned char *block, unsigned pattern)
+{
+   Outcome outcome;
+   const unsigned char *counts =
+       block + PATTERNS * 8 + pattern * COUNTS_SIZE;
+   for (int c = 0; c < CATEGORIES; ++c) {
+      outcome.categories[c] = static_cast<uint32_t>(get(counts + 4 * c, 4));
+      outcome.draws += outcome.categories[c];
+   }
+   outcome.expected = bit_cast<double>(get(block + pattern * 8, 8));
+   return outcome;
+}
+
+DrawTable::Outcome DrawTable::lookup(const CardId *ids, unsigned pattern) const
+{
+   array<unsigned, 5> positions;
+   const unsigned char *block = locate(ids, positions);
+   if (!block || pattern >= PATTERNS) {
+      return {};
+   }
+   unsigned canonical = 0;
+   for (int i = 0; i < DrawOptimizer::HAND_SIZE; ++i) {
+      canonical |= (pattern >> i & 1) << positions[i];
+   }
+   return decode(block, canonical);
+}
+
+DrawTable::Outcome DrawTable::lookup(
+    const shared_ptr<Hand> &hand, const vector<int> &discards
+) const
+{
+   if (!hand || !hand->isValid() ||
+       hand->size() != DrawOptimizer::HAND_SIZE) {
+      return {};
+   }
+   CardId ids[DrawOptimizer::HAND_SIZE];
+   for (int i = 0; i < DrawOptimizer::HAND_SIZE; ++i) {
+      ids[i] = hand->get(i)->getId();
+   }
+   unsigned pattern = 0;
+   for (int idx : discards) {
+      if (idx < 0 || idx >= DrawOptimizer::HAND_SIZE) {
+         return {};
+      }
+      pattern |= 1u << idx;
+   }
+   return lookup(ids, pattern);
+}
+
+bool DrawTable::best(const CardId *ids, DrawOptimizer::Choice &choice) const
+{
+   array<unsigned, 5> positions;
+   const unsigned char *block = locate(ids, positions);
+   if (!block) {
+      return false;
+   }
+   array<double, PATTERNS> scores;
+   for (unsigned pattern = 0; pattern < PATTERNS; ++pattern) {
+      unsigned canonical = 0;
+      for (int i = 0; i < DrawOptimizer::HAND_SIZE; ++i) {
+         canonical |= (pattern >> i & 1) << positions[i];
+      }
+      scores[pattern] = bit_cast<double>(get(block + canonical * 8, 8));
+   }
+   choice = DrawOptimizer::best(scores);
+   return true;
+}
+
+vector<int> DrawTable::discard(const shared_ptr<Hand> &hand) const
+{
+   if (!hand || !hand->isValid() ||
+       hand->size() != DrawOptimizer::HAND_SIZE) {
+      return DrawOptimizer::discard(hand); ///< Warns of the invalid hand
+   }
+   CardId ids[DrawOptimizer::HAND_SIZE];
+   for (int i = 0; i < DrawOptimizer::HAND_SIZE; ++i) {
+      ids[i] = hand->get(i)->getId();
+   }
+   DrawOptimizer::Choice choice;
+   if (!best(ids, choice)) {
+      choice = DrawOptimizer::best(ids);
+   }
+   return DrawOptimizer::toIndices(choice.pattern);
+}
+
+void DrawTable::install(const string &path)
+{
+   lock_guard<mutex> lock(sharedLock);
+   sharedPath = path;
+   sharedTable.reset();
+   sharedTried = false;
+   sharedVersion.fetch_add(1, memory_order_release);
+}
+
+const shared_ptr<const DrawTable> &DrawTable::shared()
+{
+   ///< Each thread keeps the table it last saw, and only takes the lock
+   ///< again once install() has named another file
+   thread_local shared_ptr<const DrawTable> cached;
+   thread_local uint64_t seen = 0;
+   if (sharedVersion.load(memory_order_acquire) != seen) {
+      lock_guard<mutex> lock(sharedLock);
+      if (!sharedTried && !sharedPath.empty()) {
+         sharedTried = true;
+         auto table = make_shared<DrawTable>();
+         if (table->open(sharedPath)) {
+            sharedTable = table;
+         }
+      }
+      cached = sharedTable;
+      seen = sharedVersion.load(memory_order_relaxed);
+   }
+   return cached;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file src/game/analysis/DrawTable.h
+ * @brief Precomputed outcomes of every discard, read from a mapped file.
+ */
+#ifndef DRAW_TABLE_H
+#define DRAW_TABLE_H
+
+#include "../resources/CardBits.h"
+#include "../resources/Hand.h"
+#include "../resources/SuitIsomorphism.h"
+#include "DrawOptimizer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class DrawTable
+ * @brief Answers draw questions from a table of every discard's outcomes.
+ *
+ * For every SuitIsomorphism class of five card hands and every one of its
+ * 32 discard patterns, the table holds how many draws end in each
+ * PokerHand::Category and the mean final class rank, as DrawOptimizer
+ * scores it. A question about any hand is one lookup in the record of its
+ * canonical form.
+ *
+ * The table is written once, offline, by generate(). A table file starts
+ * with a 16 byte header: the magic "PKDT", the format version, the number
+ * of categories, the number of classes and the number of patterns. A block
+ * per class follows, in class index order: the f64 mean rank of each
+ * pattern, then the 9 u32 category counts of each pattern. Bit i of a
+ * pattern discards the i-th lowest card id of the canonical hand. Means
+ * come first so the best discard is read from four cache lines. Integers
+ * are little-endian and means are IEEE 754 doubles.
+ *
+ * open() maps the file read-only and shares its pages with every process
+ * mapping it. Nothing is read up front; each lookup faults in the one or
+ * two pages holding its class, so opening costs the same for any size.
+ */
+class DrawTable
+{
+ public:
+   static constexpr std::array<char, 4> MAGIC = {'P', 'K', 'D', 'T'};
+   static constexpr std::uint16_t VERSION = 1; ///< Current format version
+   static constexpr int HEADER_SIZE = 16;      ///< Bytes before the records
+   static constexpr int CATEGORIES = 9;        ///< Valid hand categories
+   static constexpr int PATTERNS = DrawOptimizer::PATTERNS; ///< Per class
+   static constexpr int COUNTS_SIZE = CATEGORIES * 4;       ///< Bytes
+   static constexpr int CLASS_SIZE = PATTERNS * (8 + COUNTS_SIZE); ///< Bytes
+   static constexpr char DEFAULT_PATH[] = "draws.pkdt"; ///< Usual table file
+
+   /**
+    * @brief The outcomes of one discard.
+    */
+   struct Outcome
+   {
+      std::array<std::uint32_t, CATEGORIES> categories{}; ///< Final hands
+      std::uint32_t draws = 0; ///< Zero if the question was not in the table
+      double expected = 0;     ///< Mean final class rank
+   };
+
+   /**
+    * @brief Constructs a table with no file open.
+    */
+   DrawTable() = default;
+
+   /**
+    * @brief Unmaps the file, if open.
+    */
+   ~DrawTable();
+
+   DrawTable(const DrawTable &) = delete;
+   DrawTable &operator=(const DrawTable &) = delete;
+
+   /**
+    * @brief Computes the table and writes it to a file.
+    *
+    * @param path The file to write, replaced if it exists.
+    * @param classes Writes only the first classes, in class index order.
+    * @return true if the whole table was written.
+    */
+   static bool generate(
+       const std::string &path,
+       std::uint32_t classes = SuitIsomorphism::CLASS_COUNT
+   );
+
+   /**
+    * @brief Maps a table file, closing any file already open.
+    *
+    * @param path The table file.
+    * @return true if the file is a current table and was mapped.
+    */
+   bool open(const std::string &path);
+
+   /**
+    * @brief Returns whether a table is mapped.
+    *
+    * @return true if open.
+    */
+   bool isOpen() const;
+
+   /**
+    * @brief Returns the number of classes the table holds.
+    *
+    * @return std::uint32_t
+    */
+   std::uint32_t getClassCount() const;
+
+   /**
+    * @brief Looks up the outcomes of a discard.
+    *
+    * @param ids The five distinct card ids, in hand order.
+    * @param pattern The discard pattern, bit i discarding hand index i.
+    * @return Outcome The outcomes, or zero draws if the table lacks the hand.
+    */
+   Outcome lookup(const CardId *ids, unsigned pattern) const;
+
+   /**
+    * @brief Looks up the outcomes of a discard from a hand.
+    *
+    * @param hand A valid five card hand.
+    * @param discards The hand indices to discard.
+    * @return Outcome The outcomes, or zero draws if the hand is not valid
+    * or the table lacks it.
+    */
+   Outcome lookup(
+       const std::shared_ptr<Hand> &hand, const std::vector<int> &discards
+   ) const;
+
+   /**
+    * @brief Returns the discard with the highest mean final class rank.
+    * @details Chooses as DrawOptimizer::best does.
+    *
+    * @param ids The five distinct card ids, in hand order.
+    * @param choice Receives the best pattern and its score.
+    * @return true if the table holds the hand.
+    */
+   bool best(const CardId *ids, DrawOptimizer::Choice &choice) const;
+
+   /**
+    * @brief Returns the best discard of a hand as indices.
+    * @details Hands the table lacks are scored by DrawOptimizer instead.
+    *
+    * @param hand A valid five card hand.
+    * @return std::vector<int> The hand indices to discard, ascending, or
+    * none if the hand is not valid.
+    */
+   std::vector<int> discard(const std::shared_ptr<Hand> &hand) const;
+
+   /**
+    * @brief Names the table file shared() maps.
+    * @details Only records the path, so it costs nothing at startup. A
+    * table already shared stays alive for those holding it.
+    *
+    * @param path The table file.
+    */
+   static void install(const std::string &path);
+
+   /**
+    * @brief Returns the installed table, mapping it on first use.
+    * @details Each thread takes a lock only on its first call after an
+    * install(); later calls read a per-thread copy, so players can ask on
+    * every discard without contending.
+    *
+    * @return const std::shared_ptr<const DrawTable>& The table, or null if
+    * none is installed or its file cannot be mapped. The reference is the
+    * calling thread's copy, good until its next call; copy it to keep the
+    * table alive for longer.
+    */
+   static const std::shared_ptr<const DrawTable> &shared();
+
+ private:
+   const unsigned char *data = nullptr; ///< The mapped file
+   std::size_t length = 0;              ///< Bytes mapped
+   std::uint32_t classes = 0;           ///< Classes in the file
+
+   /**
+    * @brief Unmaps the file, if open.
+    */
+   void close();
+
+   /**
+    * @brief Finds a hand's class and the canonical position of each card.
+    *
+    * @param ids The five card ids, in hand order.
+    * @param positions Receives each card's bit in table patterns.
+    * @return const unsigned char* The class's block, or null if the table
+    * lacks the hand.
+    */
+   const unsigned char *
+   locate(const CardId *ids, std::array<unsigned, 5> &positions) const;
+
+   /**
+    * @brief Decodes the outcomes of one pattern.
+    *
+    * @param block The class's block.
+    * @param pattern The pattern, in canonical card order.
+    * @return Outcome
+    */
+   static Outcome decode(const unsigned char *block, unsigned pattern);
+};
+
+#endif // DRAW_TABLE_H
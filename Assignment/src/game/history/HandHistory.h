@@ -0,0 +1,127 @@
+/**
+ * @file src/game/history/HandHistory.h
+ * @brief Defines the binary hand-history format.
+ */
+#ifndef HANDHISTORY_H
+#define HANDHISTORY_H
+
+#include "../resources/CardBits.h"
+#include "../resources/HandRank.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class HandHistory
+ * @brief The events of recorded hands and their encoding.
+ *
+ * A history file starts with an 8 byte header: the magic "PKHH", the format
+ * version and two reserved bytes. Hands follow, appended one after another.
+ * Each hand is a HAND event, then its SEAT, ANTE, DEAL, BET, DISCARD,
+ * REPLACE and WIN events in the order they happened, then an END event.
+ * A reader can therefore tell a hand cut short by a crash from a complete
+ * one, and gather a whole hand back into a Hand for replaying.
+ *
+ * Every event starts with its type byte and a seat byte, followed by a
+ * payload fixed by the type. Integers are little-endian and amounts are
+ * IEEE 754 doubles, so histories read back on any host:
+ *
+ * | Event   | Payload                                     | Seat byte   |
+ * |---------|---------------------------------------------|-------------|
+ * | HAND    | u64 hand number, f64 ante, u8 dealer seat   | Seats       |
+ * | SEAT    | f64 balance before the ante                 | Seat        |
+ * | ANTE    | f64 amount paid, 0 if the player could not  | Seat        |
+ * | DEAL    | u8 count, count card ids                    | Seat        |
+ * | BET     | u8 Action, f64 amount                       | Seat        |
+ * | DISCARD | u8 count, count hand indices                | Seat        |
+ * | REPLACE | u8 count, count card ids                    | Seat        |
+ * | WIN     | f64 share of the pot, u16 winning HandRank  | Seat        |
+ * | END     | none                                        | 0           |
+ */
+class HandHistory
+{
+ public:
+   static constexpr std::array<char, 4> MAGIC = {'P', 'K', 'H', 'H'};
+   static constexpr std::uint16_t VERSION = 3; ///< Current format version
+   static constexpr int HEADER_SIZE = 8;       ///< Bytes before the first hand
+   static constexpr int MAX_CARDS = 5;         ///< Most cards in one event
+
+   /**
+    * @brief The kinds of event.
+    */
+   enum EventType : std::uint8_t
+   {
+      HAND = 1,
+      SEAT,
+      ANTE,
+      DEAL,
+      BET,
+      DISCARD,
+      REPLACE,
+      WIN,
+      END,
+   };
+
+   /**
+    * @brief What a player did with a bet.
+    */
+   enum Action : std::uint8_t
+   {
+      FOLD,
+      CALL,
+      RAISE,
+      ALL_IN,
+   };
+
+   /**
+    * @brief One decoded event; only the fields of its type are set.
+    */
+   struct Event
+   {
+      EventType type = END;
+      std::uint8_t seat = 0;   ///< Seat, or seat count for HAND
+      Action action = FOLD;    ///< BET
+      std::uint64_t hand = 0;  ///< HAND
+      std::uint8_t dealer = 0; ///< HAND
+      double amount = 0;       ///< HAND ante, SEAT, ANTE, BET and WIN
+      std::uint8_t count = 0;  ///< DEAL, DISCARD and REPLACE
+      HandRank rank;           ///< WIN
+      std::array<std::uint8_t, MAX_CARDS> values{}; ///< Card ids or indices
+   };
+
+   /**
+    * @brief One recorded bet.
+    */
+   struct Bet
+   {
+      Action action = FOLD; ///< What the player did
+      double amount = 0;    ///< The amount bet
+   };
+
+   /**
+    * @brief What one seat did during a recorded hand.
+    */
+   struct Seat
+   {
+      double balance = 0;        ///< Balance before the ante
+      double ante = 0;           ///< Ante paid, 0 if it could not be
+      std::vector<Bet> bets;     ///< Bets in the order made
+      std::vector<int> discards; ///< Hand indices discarded
+      double won = 0;            ///< Share of the pot
+      HandRank rank;             ///< Rank of the hand that won it
+   };
+
+   /**
+    * @brief A whole recorded hand.
+    */
+   struct Hand
+   {
+      std::uint64_t number = 0;  ///< The hand number
+      double ante = 0;           ///< The ante
+      int dealer = 0;            ///< The dealer's seat
+      std::vector<Seat> seats;   ///< Every seat at the table
+      std::vector<CardId> cards; ///< Every card dealt, in dealing order
+   };
+};
+
+#endif // HANDHISTORY_H
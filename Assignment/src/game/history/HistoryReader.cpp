@@ -0,0 +1,239 @@
+/**
+ * @file src/game/history/HistoryReader.cpp
+ * @brief Implementation of the HistoryReader class.
+ */
+#include "HistoryReader.h"
+#include "../../../utils/Logger.h"
+#include <algorithm>
+#include <bit>
+
+using namespace std;
+
+HistoryReader::HistoryReader(const string &path) : file(path, ios::binary)
+{
+   if (!file) {
+      Logger::warn("Cannot open hand history " + path + ".");
+      return;
+   }
+   bool matches = ensure(HandHistory::HEADER_SIZE) &&
+                  equal(
+                      HandHistory::MAGIC.begin(), HandHistory::MAGIC.end(),
+                      block.begin()
+                  );
+   if (matches) {
+      position = HandHistory::MAGIC.size();
+      matches = get(2) == HandHistory::VERSION;
+      position = HandHistory::HEADER_SIZE;
+   }
+   if (!matches) {
+      Logger::warn(path + " is not a current hand history.");
+      file.close();
+   }
+}
+
+bool HistoryReader::isOpen() const
+{
+   return file.is_open();
+}
+
+bool HistoryReader::next(HandHistory::Event &event)
+{
+   if (!file.is_open() || malformed) {
+      return false;
+   }
+   if (!ensure(2)) {
+      malformed = position < block.size(); ///< A stray byte at the end
+      return false;
+   }
+   event.type = static_cast<HandHistory::EventType>(block[position]);
+   event.seat = static_cast<uint8_t>(block[position + 1]);
+
+   size_t payload = 0;
+   switch (event.type) {
+      case HandHistory::HAND:
+         payload = 17;
+         break;
+      case HandHistory::SEAT:
+      case HandHistory::ANTE:
+         payload = 8;
+         break;
+      case HandHistory::WIN:
+         payload = 10;
+         break;
+      case HandHistory::BET:
+         payload = 9;
+         break;
+      case HandHistory::DEAL:
+      case HandHistory::DISCARD:
+      case HandHistory::REPLACE:
+         payload = 1;
+         break;
+      case HandHistory::END:
+         break;
+      default:
+         malformed = true;
+         return false;
+   }
+   if (!ensure(2 + payload)) {
+      malformed = true;
+      return false;
+   }
+   position += 2;
+
+   switch (event.type) {
+      case HandHistory::HAND:
+         event.hand = get(8);
+         event.amount = getDouble();
+         event.dealer = get(1);
+         break;
+      case HandHistory::BET:
+         event.action = static_cast<HandHistory::Action>(get(1));
+         event.amount = getDouble();
+         break;
+      case HandHistory::DEAL:
+      case HandHistory::DISCARD:
+      case HandHistory::REPLACE:
+         if (!getBytes(event)) {
+            malformed = true;
+            return false;
+         }
+         break;
+      case HandHistory::WIN:
+         event.amount = getDouble();
+         event.rank = HandRank(static_cast<uint16_t>(get(2)));
+         break;
+      case HandHistory::END:
+         break;
+      default:
+         event.amount = getDouble();
+         break;
+   }
+   complete = event.type == HandHistory::END;
+   return true;
+}
+
+bool HistoryReader::next(HandHistory::Hand &hand)
+{
+   HandHistory::Event event;
+   if (!next(event)) {
+      return false;
+   }
+   if (event.type != HandHistory::HAND) {
+      malformed = true;
+      return false;
+   }
+   vector<HandHistory::Event> deals; ///< The first deal, seat by seat
+   vector<CardId> replaced;          ///< Replacements, in drawing order
+   auto begin = [&](const HandHistory::Event &start) {
+      hand.number = start.hand;
+      hand.ante = start.amount;
+      hand.dealer = start.dealer;
+      hand.seats.assign(start.seat, HandHistory::Seat());
+      hand.cards.clear();
+      deals.clear();
+      replaced.clear();
+   };
+   begin(event);
+
+   while (next(event)) {
+      if (event.type == HandHistory::END) {
+         ///< Deal round by round, as the engine dealt them
+         for (int card = 0; card < HandHistory::MAX_CARDS; ++card) {
+            for (auto &deal : deals) {
+               if (card < deal.count) {
+                  hand.cards.push_back(deal.values[card]);
+               }
+            }
+         }
+         hand.cards.insert(hand.cards.end(), replaced.begin(), replaced.end());
+         return true;
+      }
+      ///< A hand that never ended, from an older writer, is skipped
+      if (event.type == HandHistory::HAND) {
+         begin(event);
+         continue;
+      }
+      if (event.seat >= hand.seats.size()) {
+         malformed = true;
+         return false;
+      }
+      auto &seat = hand.seats[event.seat];
+      switch (event.type) {
+         case HandHistory::SEAT:
+            seat.balance = event.amount;
+            break;
+         case HandHistory::ANTE:
+            seat.ante = event.amount;
+            break;
+         case HandHistory::DEAL:
+            deals.push_back(event);
+            break;
+         case HandHistory::BET:
+            seat.bets.push_back({event.action, event.amount});
+            break;
+         case HandHistory::DISCARD:
+            seat.discards.assign(
+                event.values.begin(), event.values.begin() + event.count
+            );
+            break;
+         case HandHistory::REPLACE:
+            replaced.insert(
+                replaced.end(), event.values.begin(),
+                event.values.begin() + event.count
+            );
+            break;
+         case HandHistory::WIN:
+            seat.won += event.amount;
+            seat.rank = event.rank;
+            break;
+         default:
+            break;
+      }
+   }
+   return false;
+}
+
+bool HistoryReader::isComplete() const
+{
+   return complete && !malformed;
+}
+
+bool HistoryReader::ensure(size_t bytes)
+{
+   if (block.size() - position >= bytes) {
+      return true;
+   }
+   ///< Keep the undecoded tail and read the next block after it
+   block.erase(block.begin(), block.begin() + position);
+   position = 0;
+   size_t kept = block.size();
+   block.resize(kept + max(bytes, BLOCK_SIZE));
+   file.read(block.data() + kept, block.size() - kept);
+   block.resize(kept + file.gcount());
+   return block.size() >= bytes;
+}
+
+uint64_t HistoryReader::get(int bytes)
+{
+   uint64_t value = 0;
+   for (int i = 0; i < bytes; ++i) {
+      value |= uint64_t(uint8_t(block[position++])) << (8 * i);
+   }
+   return value;
+}
+
+double HistoryReader::getDouble()
+{
+   return bit_cast<double>(get(8));
+}
+
+bool HistoryReader::getBytes(HandHistory::Event &event)
+{
+   event.count = static_cast<uint8_t>(get(1));
+   if (event.count > HandHistory::MAX_CARDS || !ensure(event.count)) {
+      return false;
+   }
+   copy_n(block.begin() + position, event.count, event.values.begin());
+   position += event.count;
+   return true;
+}
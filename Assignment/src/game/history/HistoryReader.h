@@ -0,0 +1,107 @@
+/**
+ * @file src/game/history/HistoryReader.h
+ * @brief Reads hand histories back from a binary file.
+ */
+#ifndef HISTORYREADER_H
+#define HISTORYREADER_H
+
+#include "HandHistory.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class HistoryReader
+ * @brief Decodes the events of a history file one at a time.
+ *
+ * The file is read in large blocks, so scanning millions of recorded hands
+ * costs about one read per block and a few byte loads per event. Events
+ * can also be gathered a whole hand at a time for replaying.
+ */
+class HistoryReader
+{
+ public:
+   static constexpr size_t BLOCK_SIZE = 1 << 16; ///< Bytes read at a time
+
+   /**
+    * @brief Opens a history file and checks its header.
+    * @details Logs a warning and stays closed if the file cannot be opened
+    * or holds a different format.
+    *
+    * @param path The file.
+    */
+   explicit HistoryReader(const std::string &path);
+
+   /**
+    * @brief Returns whether the file opened with a current header.
+    *
+    * @return true if events can be read.
+    */
+   bool isOpen() const;
+
+   /**
+    * @brief Decodes the next event.
+    *
+    * @param event Receives the event.
+    * @return true if an event was read, false at the end of the file or
+    * at an event that is cut short or unknown.
+    */
+   bool next(HandHistory::Event &event);
+
+   /**
+    * @brief Decodes the events of the next hand.
+    * @details The cards are put back in dealing order: the first deal
+    * round by round, seat by seat, then the replacements in the order they
+    * were drawn. A hand that another hand starts before its END was
+    * abandoned, and is skipped.
+    *
+    * @param hand Receives the hand.
+    * @return true if a whole hand was read, false at the end of the file
+    * or at a hand that is cut short or malformed.
+    */
+   bool next(HandHistory::Hand &hand);
+
+   /**
+    * @brief Returns whether reading stopped cleanly after a whole hand.
+    *
+    * @return true once next() has returned false at the end of the file,
+    * just after an END event or before any hand.
+    */
+   bool isComplete() const;
+
+ private:
+   std::ifstream file;      ///< The open history
+   std::vector<char> block; ///< Bytes read but not yet decoded
+   size_t position = 0;     ///< Next byte of the block to decode
+   bool complete = true;    ///< Last event read was END, or none yet
+   bool malformed = false;  ///< Met an event it could not decode
+
+   /**
+    * @brief Makes sure a number of bytes are ready to decode.
+    *
+    * @param bytes The bytes needed.
+    * @return true if the file holds that many more bytes.
+    */
+   bool ensure(size_t bytes);
+
+   /**
+    * @brief Decodes a little-endian unsigned integer.
+    */
+   std::uint64_t get(int bytes);
+
+   /**
+    * @brief Decodes an IEEE 754 double.
+    */
+   double getDouble();
+
+   /**
+    * @brief Decodes a count and that many bytes.
+    *
+    * @param event Receives the count and bytes.
+    * @return true if they were all there.
+    */
+   bool getBytes(HandHistory::Event &event);
+};
+
+#endif // HISTORYREADER_H
@@ -0,0 +1,205 @@
+/**
+ * @file src/game/history/HistoryWriter.cpp
+ * @brief Implementation of the HistoryWriter class.
+ */
+#include "HistoryWriter.h"
+#include "../../../utils/Logger.h"
+#include <algorithm>
+#include <bit>
+
+using namespace std;
+
+HistoryWriter::HistoryWriter(const string &path, size_t bufferSize)
+    : capacity(max<size_t>(bufferSize, 64))
+{
+   buffer.reserve(capacity + 256);
+   open(path);
+}
+
+HistoryWriter::~HistoryWriter()
+{
+   abortHand();
+   flush();
+}
+
+bool HistoryWriter::isOpen() const
+{
+   return file.is_open();
+}
+
+bool HistoryWriter::rotate(const string &path)
+{
+   flush();
+   file.close();
+   return open(path);
+}
+
+bool HistoryWriter::open(const string &path)
+{
+   char header[HandHistory::HEADER_SIZE] = {};
+   ifstream existing(path, ios::binary);
+   existing.read(header, sizeof(header));
+   auto found = existing.gcount();
+   existing.close();
+
+   if (found > 0) {
+      bool matches = found == HandHistory::HEADER_SIZE &&
+                     equal(
+                         HandHistory::MAGIC.begin(), HandHistory::MAGIC.end(),
+                         header
+                     ) &&
+                     (uint8_t(header[4]) | uint8_t(header[5]) << 8) ==
+                         HandHistory::VERSION;
+      if (!matches) {
+         Logger::warn("Cannot append to " + path + ", not a current history.");
+         return false;
+      }
+   }
+
+   file.open(path, ios::binary | ios::app);
+   if (!file) {
+      Logger::warn("Cannot open hand history " + path + ".");
+      return false;
+   }
+   if (found == 0) {
+      copy(HandHistory::MAGIC.begin(), HandHistory::MAGIC.end(), header);
+      header[4] = char(HandHistory::VERSION & 0xFF);
+      header[5] = char(HandHistory::VERSION >> 8);
+      file.write(header, sizeof(header));
+      written += sizeof(header);
+   }
+   Logger::debug("Recording hand history to " + path + ".");
+   return true;
+}
+
+void HistoryWriter::beginHand(
+    uint64_t hand, int seats, double ante, int dealer
+)
+{
+   abortHand();
+   opened = buffer.size();
+   start(HandHistory::HAND, seats);
+   put(hand, 8);
+   put(ante);
+   put(dealer, 1);
+}
+
+void HistoryWriter::seat(int seat, double balance)
+{
+   start(HandHistory::SEAT, seat);
+   put(balance);
+}
+
+void HistoryWriter::ante(int seat, double amount)
+{
+   start(HandHistory::ANTE, seat);
+   put(amount);
+}
+
+void HistoryWriter::deal(int seat, const CardId *ids, int count)
+{
+   start(HandHistory::DEAL, seat);
+   putBytes(ids, count);
+}
+
+void HistoryWriter::bet(int seat, HandHistory::Action action, double amount)
+{
+   start(HandHistory::BET, seat);
+   put(action, 1);
+   put(amount);
+}
+
+void HistoryWriter::discard(int seat, const vector<int> &indices)
+{
+   CardId values[HandHistory::MAX_CARDS];
+   int count = min<int>(indices.size(), HandHistory::MAX_CARDS);
+   for (int i = 0; i < count; ++i) {
+      values[i] = static_cast<CardId>(indices[i]);
+   }
+   start(HandHistory::DISCARD, seat);
+   putBytes(values, count);
+}
+
+void HistoryWriter::replace(int seat, const CardId *ids, int count)
+{
+   start(HandHistory::REPLACE, seat);
+   putBytes(ids, count);
+}
+
+void HistoryWriter::win(int seat, double amount, HandRank rank)
+{
+   start(HandHistory::WIN, seat);
+   put(amount);
+   put(rank.getValue(), 2);
+}
+
+void HistoryWriter::endHand()
+{
+   start(HandHistory::END, 0);
+   opened = NO_HAND;
+   hands++;
+   if (buffer.size() >= capacity) {
+      flush();
+   }
+}
+
+void HistoryWriter::abortHand()
+{
+   if (opened != NO_HAND) {
+      buffer.resize(opened);
+      opened = NO_HAND;
+   }
+}
+
+void HistoryWriter::flush()
+{
+   ///< The open hand, if any, stays buffered until it ends
+   size_t ended = opened == NO_HAND ? buffer.size() : opened;
+   if (ended == 0) {
+      return;
+   }
+   if (file.is_open()) {
+      file.write(buffer.data(), ended);
+      file.flush();
+      written += ended;
+   }
+   buffer.erase(buffer.begin(), buffer.begin() + ended);
+   if (opened != NO_HAND) {
+      opened = 0;
+   }
+}
+
+uint64_t HistoryWriter::getHands() const
+{
+   return hands;
+}
+
+uint64_t HistoryWriter::getBytes() const
+{
+   return written + buffer.size();
+}
+
+void HistoryWriter::start(HandHistory::EventType type, int seat)
+{
+   buffer.push_back(char(type));
+   buffer.push_back(char(seat));
+}
+
+void HistoryWriter::put(uint64_t value, int bytes)
+{
+   for (int i = 0; i < bytes; ++i) {
+      buffer.push_back(char(value >> (8 * i)));
+   }
+}
+
+void HistoryWriter::put(double value)
+{
+   put(bit_cast<uint64_t>(value), 8);
+}
+
+void HistoryWriter::putBytes(const CardId *values, int count)
+{
+   count = clamp(count, 0, HandHistory::MAX_CARDS);
+   buffer.push_back(char(count));
+   buffer.insert(buffer.end(), values, values + count);
+}
@@ -0,0 +1,208 @@
+/**
+ * @file src/game/history/HistoryWriter.h
+ * @brief Streams hand histories to a binary file.
+ */
+#ifndef HISTORYWRITER_H
+#define HISTORYWRITER_H
+
+#include "../resources/CardBits.h"
+#include "HandHistory.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class HistoryWriter
+ * @brief Appends hands to a history file through a memory buffer.
+ *
+ * Events are encoded into the buffer as they happen. The buffer is only
+ * written out once it is full and a hand has ended, so recording costs a
+ * few byte copies per event and one write per batch of hands. Only ended
+ * hands are ever written: a hand still open stays in the buffer, and one
+ * abandoned by abortHand(), by the next beginHand() or by closing the
+ * writer is dropped, so files hold whole hands unless the process dies
+ * mid write. Opening an existing history appends to it, after checking it
+ * has the current version. rotate() moves recording to a new file so long
+ * runs can be split up.
+ */
+class HistoryWriter
+{
+ public:
+   static constexpr size_t DEFAULT_BUFFER = 1 << 16; ///< Bytes per batch
+
+   /**
+    * @brief Opens a history file for appending.
+    * @details Logs a warning and stays closed if the file cannot be opened
+    * or holds a different format.
+    *
+    * @param path The file to append to, created if missing.
+    * @param bufferSize Bytes gathered before writing to the file.
+    */
+   explicit HistoryWriter(
+       const std::string &path, size_t bufferSize = DEFAULT_BUFFER
+   );
+
+   /**
+    * @brief Writes out the buffered hands that ended.
+    */
+   ~HistoryWriter();
+
+   HistoryWriter(const HistoryWriter &) = delete;
+   HistoryWriter &operator=(const HistoryWriter &) = delete;
+
+   /**
+    * @brief Returns whether events reach a file.
+    *
+    * @return true if the file opened.
+    */
+   bool isOpen() const;
+
+   /**
+    * @brief Flushes and closes the current file and appends to another.
+    * @details A hand still open is written to the new file when it ends.
+    *
+    * @param path The next file.
+    * @return true if the new file opened.
+    */
+   bool rotate(const std::string &path);
+
+   /**
+    * @brief Starts a hand, dropping any hand that was never ended.
+    *
+    * @param hand The hand number.
+    * @param seats The number of seats at the table.
+    * @param ante The ante for the hand.
+    * @param dealer The dealer's seat.
+    */
+   void beginHand(std::uint64_t hand, int seats, double ante, int dealer);
+
+   /**
+    * @brief Records a seat's balance before the ante.
+    *
+    * @param seat The seat.
+    * @param balance The balance.
+    */
+   void seat(int seat, double balance);
+
+   /**
+    * @brief Records an ante, or 0 if the player could not pay it.
+    *
+    * @param seat The seat.
+    * @param amount The amount paid.
+    */
+   void ante(int seat, double amount);
+
+   /**
+    * @brief Records the cards dealt to a seat, in the order dealt.
+    *
+    * @param seat The seat.
+    * @param ids The card ids.
+    * @param count The number of cards, at most HandHistory::MAX_CARDS.
+    */
+   void deal(int seat, const CardId *ids, int count);
+
+   /**
+    * @brief Records a bet.
+    *
+    * @param seat The seat.
+    * @param action What the player did.
+    * @param amount The amount bet.
+    */
+   void bet(int seat, HandHistory::Action action, double amount);
+
+   /**
+    * @brief Records the hand indices a seat discarded, none to stand pat.
+    *
+    * @param seat The seat.
+    * @param indices The hand indices.
+    */
+   void discard(int seat, const std::vector<int> &indices);
+
+   /**
+    * @brief Records the replacement cards dealt to a seat.
+    *
+    * @param seat The seat.
+    * @param ids The card ids.
+    * @param count The number of cards, at most HandHistory::MAX_CARDS.
+    */
+   void replace(int seat, const CardId *ids, int count);
+
+   /**
+    * @brief Records a seat's share of the pot.
+    *
+    * @param seat The seat.
+    * @param amount The share.
+    * @param rank The rank of the hand that won it.
+    */
+   void win(int seat, double amount, HandRank rank = HandRank());
+
+   /**
+    * @brief Ends a hand, writing the buffer out if it is full.
+    */
+   void endHand();
+
+   /**
+    * @brief Drops the events of the open hand, if any.
+    */
+   void abortHand();
+
+   /**
+    * @brief Writes out the events of every hand that ended.
+    */
+   void flush();
+
+   /**
+    * @brief Returns the number of hands ended.
+    *
+    * @return std::uint64_t
+    */
+   std::uint64_t getHands() const;
+
+   /**
+    * @brief Returns the number of bytes recorded, buffered or written.
+    *
+    * @return std::uint64_t
+    */
+   std::uint64_t getBytes() const;
+
+ private:
+   static constexpr size_t NO_HAND = SIZE_MAX; ///< No hand is open
+
+   std::ofstream file;        ///< The open history
+   std::vector<char> buffer;  ///< Encoded events not yet written
+   size_t capacity;           ///< Buffer size that triggers a write
+   std::uint64_t hands = 0;   ///< Hands ended
+   std::uint64_t written = 0; ///< Bytes written to files
+   size_t opened = NO_HAND;   ///< Buffer offset of the open hand
+
+   /**
+    * @brief Opens a file, writing or checking its header.
+    *
+    * @param path The file.
+    * @return true if the file opened.
+    */
+   bool open(const std::string &path);
+
+   /**
+    * @brief Appends an event's type and seat.
+    */
+   void start(HandHistory::EventType type, int seat);
+
+   /**
+    * @brief Appends a little-endian unsigned integer.
+    */
+   void put(std::uint64_t value, int bytes);
+
+   /**
+    * @brief Appends an IEEE 754 double.
+    */
+   void put(double value);
+
+   /**
+    * @brief Appends a count and that many bytes.
+    */
+   void putBytes(const CardId *values, int count);
+};
+
+#endif // HISTORYWRITER_H
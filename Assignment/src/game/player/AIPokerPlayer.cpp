@@ -6,6 +6,9 @@
 #include "AIPokerPlayer.h"
 #include "../../../utils/Logger.h"
 #include "../PokerEngine.h"
+#include "../analysis/DrawOptimizer.h"
+#include "../analysis/DrawTable.h"
+#include "../resources/HandStrength.h"
 #include "../resources/PokerHand.h"
 #include <algorithm>
 #include <numeric>
@@ -13,19 +16,23 @@
 using namespace std;
 using EnginePtr = shared_ptr<PokerEngine>;
 
-mt19937 AIPokerPlayer::rng(random_device{}()); ///< Initialize static RNG
-
 AIPokerPlayer::AIPokerPlayer(EnginePtr engine, int id, double balance)
     : PokerPlayer(engine, id, UserType::AI, balance),
-      strategy(Strategy::BALANCED)
+      strategy(Strategy::BALANCED), rng(random_device{}())
 {}
 
 AIPokerPlayer::AIPokerPlayer(
     EnginePtr engine, int id, double balance, Strategy strategy
 )
-    : PokerPlayer(engine, id, UserType::AI, balance), strategy(strategy)
+    : PokerPlayer(engine, id, UserType::AI, balance), strategy(strategy),
+      rng(random_device{}())
 {}
 
+void AIPokerPlayer::seed(uint32_t seed)
+{
+   rng.seed(seed);
+}
+
 vector<int> AIPokerPlayer::discard()
 {
    PokerHand::Category category = (PokerHand::Category)hand->getCategory();
@@ -37,6 +44,16 @@ vector<int> AIPokerPlayer::discard()
    Logger::debug(getName() + " has a " + hand->getDescription() + ".");
    Logger::debug(hand->getCardsDescription());
 
+   if (strategy == Strategy::OPTIMIZING) {
+      ///< A mapped table answers with a lookup instead of a computation
+      const auto &table = DrawTable::shared();
+      discards = table ? table->discard(hand) : DrawOptimizer::discard(hand);
+      Logger::debug(
+          getName() + " is discarding " + to_string(discards.size()) + " cards."
+      );
+      return discards;
+   }
+
    switch (category) {
       case PokerHand::Category::HIGH_CARD:
          break;
@@ -71,6 +88,20 @@ vector<int> AIPokerPlayer::discard()
    return discards;
 }
 
+double AIPokerPlayer::strength() const
+{
+   int opponents = clamp(
+       engine->getContenders() - 1, 1, HandStrength::MAX_OPPONENTS
+   );
+   auto rank = static_cast<uint16_t>(hand->getScore());
+   double win = HandStrength::getWinProbability(rank, opponents);
+
+   ///< The odds of winning, from 1 for the lowest pair heads up to the
+   ///< multiple a straight flush once earned
+   double odds = win < 1 ? win / (1 - win) : MAX_STRENGTH;
+   return clamp(odds, 1.0, MAX_STRENGTH);
+}
+
 double AIPokerPlayer::bet()
 {
    double blind = engine->getBlind();
@@ -110,11 +141,7 @@ double AIPokerPlayer::bet()
       case PokerHand::Category::FULL_HOUSE:
       case PokerHand::Category::FOUR_OF_A_KIND:
       case PokerHand::Category::STRAIGHT_FLUSH:
-         if (minBet * static_cast<double>(category) < balance) {
-            bet = minBet * static_cast<double>(category);
-         } else {
-            bet = balance;
-         }
+         bet = min(minBet * strength(), balance);
          break;
       case PokerHand::Category::INVALID_HAND:
          break;
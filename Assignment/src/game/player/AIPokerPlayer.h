@@ -6,6 +6,7 @@
 #define AIPOKERPLAYER_H
 
 #include "PokerPlayer.h"
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <string>
@@ -18,17 +19,28 @@ class PokerEngine; ///< Forward declaration of PokerEngine class
  * @brief Represents an AI poker player.
  *
  * The AIPokerPlayer class is a derived class of the PokerPlayer class and
- * provides functionality to simulate a AI poker player.
+ * provides functionality to simulate a AI poker player. The strategy sets
+ * how much of its balance the player bets. Most strategies keep the cards
+ * that make up their pairs, trips and quads and stand pat on any better
+ * hand. OPTIMIZING instead discards whatever DrawOptimizer finds gives the
+ * best expected final hand.
+ *
+ * Made hands bet a multiple of the strategy's bet that grows with the
+ * hand's odds of beating the players still in the hand, from HandStrength,
+ * so a pair of aces bets more than a pair of deuces.
  */
 class AIPokerPlayer : public PokerPlayer
 {
  public:
+   static constexpr double MAX_STRENGTH = 8; ///< Largest bet multiple
+
    /**
     * @brief Enumerates basic strategies for the AI player by percentage.
     */
    enum Strategy
    {
       AGGRESSIVE = 45,
+      OPTIMIZING = 25, ///< Draws to the best expected final hand
       BALANCED = 20,
       CONSERVATIVE = 5
    };
@@ -60,6 +72,15 @@ class AIPokerPlayer : public PokerPlayer
     */
    ~AIPokerPlayer() = default;
 
+   /**
+    * @brief Reseeds the player's random generator.
+    * @details Each player owns its generator, so players on different
+    * threads never share one, and a seed makes betting reproducible.
+    *
+    * @param seed The new seed.
+    */
+   void seed(std::uint32_t seed);
+
    /**
     * @see PokerPlayer::discard
     */
@@ -72,7 +93,17 @@ class AIPokerPlayer : public PokerPlayer
 
  protected:
    Strategy strategy; ///< Determines the AI player's strategy.
+
+   /**
+    * @brief Returns the multiple of its bet the hand deserves.
+    * @details The odds of the hand winning against random hands, one for
+    * each other player still in the hand, clamped to 1 .. MAX_STRENGTH.
+    *
+    * @return double The bet multiple.
+    */
+   double strength() const;
+
  private:
-   static std::mt19937 rng; ///<  Mersenne Twister engine for randomness
+   std::mt19937 rng; ///< Mersenne Twister engine, one per player
 };
 #endif // AIPOKERPLAYER_H
\ No newline at end of file
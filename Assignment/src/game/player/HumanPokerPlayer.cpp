@@ -19,7 +19,52 @@ HumanPokerPlayer::HumanPokerPlayer(EnginePtr engine, int id, double balance)
     : PokerPlayer(engine, id, UserType::HUMAN, balance)
 {}
 
+void HumanPokerPlayer::reset()
+{
+   input.cancel();
+   PokerPlayer::reset();
+}
+
 vector<int> HumanPokerPlayer::discard()
+{
+   auto decision = decideDiscard();
+   if (!decision.isReady()) {
+      input.cancel();
+   }
+   return decision.get();
+}
+
+double HumanPokerPlayer::bet()
+{
+   auto decision = decideBet();
+   if (!decision.isReady()) {
+      input.cancel();
+   }
+   return decision.get();
+}
+
+bool HumanPokerPlayer::readsConsole() const
+{
+   return !remote;
+}
+
+void HumanPokerPlayer::setRemote(bool remote)
+{
+   this->remote = remote;
+}
+
+void HumanPokerPlayer::answer(string line)
+{
+   Logger::debug("User input: " + line);
+   input.resolve(move(line));
+}
+
+bool HumanPokerPlayer::isWaiting() const
+{
+   return input.isWaiting();
+}
+
+Task<vector<int>> HumanPokerPlayer::decideDiscard()
 {
    string input, test, confirmation;
    vector<int> discards;
@@ -29,15 +74,14 @@ vector<int> HumanPokerPlayer::discard()
 
    Logger::console("Your current hand is: " + hand->getDescription());
    Logger::console(handDetail);
-   if (prompt("Do you want to discard any cards?")) {
+   if (co_await prompt("Do you want to discard any cards?")) {
       while (!validInput) {
          input = "", test = "", confirmation = "";
          Logger::console(
              "Enter the indices of your card replacements (space separated): ",
              false
          );
-         getline(cin, input);
-         Logger::debug("User input: " + input);
+         input = co_await readLine();
 
          // No input means no discards
          if (input.empty()) {
@@ -88,7 +132,7 @@ vector<int> HumanPokerPlayer::discard()
          } else if (validInput) {
             Logger::console("You have chosen to keep all of your cards.");
          }
-         if (prompt("Are you sure?")) {
+         if (co_await prompt("Are you sure?")) {
             break;
          } else {
             Logger::console("Action cancelled.");
@@ -107,10 +151,10 @@ vector<int> HumanPokerPlayer::discard()
       Logger::debug("You are keeping all of your cards.");
    }
 
-   return discards;
+   co_return discards;
 }
 
-double HumanPokerPlayer::bet()
+Task<double> HumanPokerPlayer::decideBet()
 {
    double amount = 0;
    double blind = engine->getBlind();
@@ -120,7 +164,8 @@ double HumanPokerPlayer::bet()
    string cBalance = PokerEngine::formatCurrency(balance);
    char choice;
    if (balance < blind) {
-      if (prompt("You can't make the blind. Do you want to go all in?")) {
+      string question = "You can't make the blind. Do you want to go all in?";
+      if (co_await prompt(question)) {
          amount = balance;
          allIn(amount);
       }
@@ -130,12 +175,11 @@ double HumanPokerPlayer::bet()
 
       do {
          Logger::console("Do you want to [R]aise, [C]all, or [F]old? ", false);
-         getline(cin, decision);
-         Logger::debug("User input: " + decision);
+         decision = co_await readLine();
          choice = toupper(decision[0]);
          switch (choice) {
             case 'R':
-               amount = captureBet();
+               amount = co_await captureBet();
                raise(amount);
                break;
             case 'C':
@@ -152,24 +196,23 @@ double HumanPokerPlayer::bet()
       } while (string("RCF").find(choice) == string::npos);
    }
    balance -= amount;
-   return amount;
+   co_return amount;
 }
 
-bool HumanPokerPlayer::prompt(string message)
+Task<bool> HumanPokerPlayer::prompt(string message)
 {
    string confirmation;
    Logger::console(message + " [Y]/n: ", false);
-   getline(cin, confirmation);
-   Logger::debug("User input: " + confirmation);
+   confirmation = co_await readLine();
    Logger::console("");
    if (toupper(confirmation[0]) == 'N') {
-      return false;
+      co_return false;
    } else {
-      return true;
+      co_return true;
    }
 }
 
-double HumanPokerPlayer::captureBet()
+Task<double> HumanPokerPlayer::captureBet()
 {
    double amount = 0;
    double blind = engine->getBlind();
@@ -180,8 +223,7 @@ double HumanPokerPlayer::captureBet()
 
    while (true) {
       Logger::console("Enter an amount" + tip + ": ", false);
-      getline(cin, sAmount);
-      Logger::debug("User input: " + sAmount);
+      sAmount = co_await readLine();
       if (!sAmount.empty()) {
          try {
             amount = stod(sAmount);
@@ -195,7 +237,7 @@ double HumanPokerPlayer::captureBet()
       }
 
       // Check if the input is a valid number and does not exceed balance
-      if (cin.fail() || (amount + 0.001) < blind) { // error margin
+      if ((amount + 0.001) < blind) { // error margin
          Logger::console("Please re-enter a valid amount.");
          continue; // Ask for the input again
       } else {
@@ -211,5 +253,16 @@ double HumanPokerPlayer::captureBet()
          }
       }
    }
-   return amount;
+   co_return amount;
+}
+
+Reply<string> &HumanPokerPlayer::readLine()
+{
+   if (!remote) {
+      string line;
+      getline(cin, line);
+      Logger::debug("User input: " + line);
+      input.resolve(move(line));
+   }
+   return input;
 }
\ No newline at end of file
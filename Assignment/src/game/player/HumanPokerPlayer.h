@@ -17,7 +17,10 @@ class PokerEngine; ///< Forward declaration of PokerEngine class
  * @brief Represents a human poker player.
  *
  * The HumanPokerPlayer class is a derived class of the PokerPlayer class and
- * provides functionality to simulate a human poker player.
+ * provides functionality to simulate a human poker player. Its dialogs are
+ * coroutines that await each line of input. A local player reads the line
+ * from standard input at once; a remote player suspends the table until
+ * answer() supplies it, so one thread can serve many tables.
  */
 class HumanPokerPlayer : public PokerPlayer
 {
@@ -39,15 +42,64 @@ class HumanPokerPlayer : public PokerPlayer
    ~HumanPokerPlayer() = default;
 
    /**
+    * @brief Gives up the current hand, and any question left unanswered.
+    * @see PokerPlayer::reset
+    */
+   void reset() override;
+
+   /**
+    * @brief Runs the discard dialog to the end.
+    * @throws std::logic_error if a remote player has not answered yet.
     * @see PokerPlayer::discard
     */
    std::vector<int> discard() override;
 
    /**
+    * @brief Runs the bet dialog to the end.
+    * @throws std::logic_error if a remote player has not answered yet.
     * @see PokerPlayer::bet
     */
    double bet() override;
 
+   /**
+    * @see PokerPlayer::decideDiscard
+    */
+   Task<std::vector<int>> decideDiscard() override;
+
+   /**
+    * @see PokerPlayer::decideBet
+    */
+   Task<double> decideBet() override;
+
+   /**
+    * @brief Returns whether the player reads standard input.
+    * @see PokerPlayer::readsConsole
+    */
+   bool readsConsole() const override;
+
+   /**
+    * @brief Takes answers from answer() instead of standard input.
+    *
+    * @param remote Whether the player answers remotely.
+    */
+   void setRemote(bool remote);
+
+   /**
+    * @brief Supplies the next line of input of a remote player.
+    * @details A dialog waiting for it resumes before this returns, and
+    * plays the table on until the next question.
+    *
+    * @param line The line, without its newline.
+    */
+   void answer(std::string line);
+
+   /**
+    * @brief Returns whether a dialog is waiting for answer().
+    *
+    * @return true if the player has a question to answer.
+    */
+   bool isWaiting() const;
+
  protected:
    /**
     * @brief Prompts the player with a message.
@@ -55,14 +107,26 @@ class HumanPokerPlayer : public PokerPlayer
     * @param message
     * @return true if yes, otherwise false
     */
-   virtual bool prompt(std::string message);
+   virtual Task<bool> prompt(std::string message);
 
  private:
+   bool remote{false};       ///< Answers come from answer().
+   Reply<std::string> input; ///< The next line of input.
+
    /**
     * @brief Captures the player bet input.
     *
     * @return The amount to bet.
     */
-   double captureBet();
+   Task<double> captureBet();
+
+   /**
+    * @brief Returns the next line of input to await.
+    * @details A local player's line is read from standard input, so it is
+    * ready at once.
+    *
+    * @return Reply<std::string>& The line.
+    */
+   Reply<std::string> &readLine();
 };
 #endif // HUMANPOKERPLAYER_H
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <memory>
 
 using namespace std;
+using CardPtr = shared_ptr<Card>;
 using EnginePtr = shared_ptr<PokerEngine>;
 
 PokerPlayer::PokerPlayer(
@@ -22,11 +23,23 @@ PokerPlayer::PokerPlayer(
       hand(make_shared<PokerHand>())
 {}
 
+void PokerPlayer::reset()
+{
+   if (hand.use_count() == 1) {
+      hand->removeCards(hand->getMask()); ///< Reuse the cards' storage
+   }
+   if (hand.use_count() > 1 || !hand->isEmpty()) {
+      hand = make_shared<PokerHand>(); ///< An Outcome still shows this one
+   }
+   state = WAITING;
+}
+
 void PokerPlayer::receive(CardCollection cards)
 {
    Logger::debug(getName() + " receives: " + cards.getCardsDescription());
    for (int i = 0; i < cards.size(); i++) {
-      hand->add(cards.get(i));
+      CardPtr card = cards.get(i);
+      hand->add(card, cards.getOrientation(card->getId()));
    }
    if (hand->isValid() && type == UserType::HUMAN) {
       if (state == ACTIVE) {
@@ -73,6 +86,14 @@ bool PokerPlayer::bet(double amount)
    return true;
 }
 
+void PokerPlayer::collect(double amount)
+{
+   Logger::debug(
+       getName() + " collects " + PokerEngine::formatCurrency(amount) + "."
+   );
+   balance += amount;
+}
+
 void PokerPlayer::raise(double amount)
 {
    state = RAISING;
@@ -109,11 +130,38 @@ void PokerPlayer::fold()
    Logger::console("");
 }
 
+Task<double> PokerPlayer::decideBet()
+{
+   return bet();
+}
+
+Task<vector<int>> PokerPlayer::decideDiscard()
+{
+   return discard();
+}
+
+bool PokerPlayer::readsConsole() const
+{
+   return type == UserType::HUMAN;
+}
+
+PokerPlayer::Outcome::Outcome(
+    string playerName, double balance, shared_ptr<PokerHand> hand
+)
+    : playerName(playerName), playerBalance(balance), playerHand(hand),
+      playerRank(hand ? hand->getRank() : HandRank())
+{}
+
 PokerPlayer::Outcome PokerPlayer::show() const
 {
    return Outcome(getName(), balance, hand);
 }
 
+double PokerPlayer::getBalance() const
+{
+   return balance;
+}
+
 PokerPlayer::Status PokerPlayer::getState() const
 {
    return state;
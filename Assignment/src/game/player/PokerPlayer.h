@@ -5,6 +5,8 @@
 #ifndef POKERPLAYER_H
 #define POKERPLAYER_H
 
+#include "../../../utils/Task.h"
+#include "../resources/HandRank.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,7 +30,9 @@ enum UserType
  * @brief Abstract base class representing a player in a poker game.
  *
  * Provides an common set of functionalities for all player actions in the game
- * to be implemented by derived human or AI player classes.
+ * to be implemented by derived human or AI player classes. The engine asks
+ * for bets and discards through awaitable decisions, so a player can keep
+ * a table waiting without holding its thread.
  */
 class PokerPlayer
 {
@@ -38,6 +42,7 @@ class PokerPlayer
       std::string playerName = "Unknown";
       double playerBalance;
       std::shared_ptr<PokerHand> playerHand;
+      HandRank playerRank; ///< The hand's rank when shown
 
       /**
        * @brief Default constructor for Outcome struct.
@@ -54,9 +59,7 @@ class PokerPlayer
       Outcome(
           std::string playerName, double balance,
           std::shared_ptr<PokerHand> hand
-      )
-          : playerName(playerName), playerBalance(balance), playerHand(hand)
-      {}
+      );
    };
 
    enum Status
@@ -90,6 +93,14 @@ class PokerPlayer
     */
    virtual ~PokerPlayer() = default;
 
+   /**
+    * @brief Gives up the current hand and waits for the next deal.
+    * @details The balance carries over. The hand is emptied in place
+    * unless an Outcome from an earlier hand still holds it, in which case
+    * the Outcome keeps it and the player starts a new one.
+    */
+   virtual void reset();
+
    /**
     * @brief Receives cards from the deck.
     *
@@ -121,6 +132,13 @@ class PokerPlayer
     */
    virtual double bet() = 0;
 
+   /**
+    * @brief Adds winnings to the player's balance.
+    *
+    * @param amount The amount won.
+    */
+   virtual void collect(double amount);
+
    /**
     * @brief Raises the current bet in the game.
     * @param amount The amount to raise the bet by.
@@ -153,6 +171,31 @@ class PokerPlayer
     */
    virtual std::vector<int> discard() = 0;
 
+   /**
+    * @brief Decides a bet, now or later.
+    * @details The engine awaits the decision, so a table can be suspended
+    * while the player thinks. By default the decision is bet(), ready at
+    * once.
+    *
+    * @return Task<double> The amount of money to bet.
+    */
+   virtual Task<double> decideBet();
+
+   /**
+    * @brief Decides which cards to discard, now or later.
+    * @details By default the decision is discard(), ready at once.
+    *
+    * @return Task<std::vector<int>> The indices of the cards to replace.
+    */
+   virtual Task<std::vector<int>> decideDiscard();
+
+   /**
+    * @brief Returns whether the player decides by reading standard input.
+    *
+    * @return true if a decision can block on the console.
+    */
+   virtual bool readsConsole() const;
+
    /**
     * @brief Returns the player's game outcome.
     *
@@ -160,6 +203,13 @@ class PokerPlayer
     */
    virtual Outcome show() const;
 
+   /**
+    * @brief Returns the player's balance.
+    *
+    * @return double The balance.
+    */
+   double getBalance() const;
+
    /**
     * @brief Returns the player's state.
     *
@@ -0,0 +1,51 @@
+/**
+ * @file src/player/ReplayPokerPlayer.cpp
+ * @brief Implementation of the derived ReplayPokerPlayer class.
+ */
+
+#include "ReplayPokerPlayer.h"
+#include "../PokerEngine.h"
+
+using namespace std;
+using EnginePtr = shared_ptr<PokerEngine>;
+
+ReplayPokerPlayer::ReplayPokerPlayer(EnginePtr engine, int id)
+    : PokerPlayer(engine, id, UserType::AI, 0.0)
+{}
+
+void ReplayPokerPlayer::load(const HandHistory::Seat &seat)
+{
+   this->seat = &seat;
+   balance = seat.balance;
+   nextBet = 0;
+}
+
+vector<int> ReplayPokerPlayer::discard()
+{
+   return seat ? seat->discards : vector<int>();
+}
+
+double ReplayPokerPlayer::bet()
+{
+   if (!seat || nextBet >= seat->bets.size()) {
+      fold();
+      return 0.0;
+   }
+   const auto &recorded = seat->bets[nextBet++];
+   switch (recorded.action) {
+      case HandHistory::FOLD:
+         fold();
+         break;
+      case HandHistory::CALL:
+         call(recorded.amount);
+         break;
+      case HandHistory::RAISE:
+         raise(recorded.amount);
+         break;
+      case HandHistory::ALL_IN:
+         allIn(recorded.amount);
+         break;
+   }
+   balance -= recorded.amount;
+   return recorded.amount;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file src/player/ReplayPokerPlayer.h
+ * @brief Defines the derived ReplayPokerPlayer class.
+ */
+#ifndef REPLAYPOKERPLAYER_H
+#define REPLAYPOKERPLAYER_H
+
+#include "../history/HandHistory.h"
+#include "PokerPlayer.h"
+#include <memory>
+#include <vector>
+
+class PokerEngine; ///< Forward declaration of PokerEngine class
+
+/**
+ * @class ReplayPokerPlayer
+ * @brief Repeats the decisions a seat made in a recorded hand.
+ *
+ * The ReplayPokerPlayer class is a derived class of the PokerPlayer class
+ * that bets and discards exactly as recorded, so an engine dealing the
+ * recorded cards plays the hand again without any input or randomness.
+ */
+class ReplayPokerPlayer : public PokerPlayer
+{
+ public:
+   /**
+    * @brief Constructs a new ReplayPokerPlayer object.
+    *
+    * @param engine The poker engine pointer.
+    * @param id The player's ID.
+    */
+   ReplayPokerPlayer(std::shared_ptr<PokerEngine> engine, int id);
+
+   /**
+    * @brief Destructs the ReplayPokerPlayer object.
+    */
+   ~ReplayPokerPlayer() = default;
+
+   /**
+    * @brief Takes the balance and decisions of a recorded seat.
+    * @details The seat is not copied, so it must outlive the hand.
+    *
+    * @param seat The recorded seat.
+    */
+   void load(const HandHistory::Seat &seat);
+
+   /**
+    * @see PokerPlayer::discard
+    */
+   std::vector<int> discard() override;
+
+   /**
+    * @brief Makes the next recorded bet, or folds once there are none.
+    * @see PokerPlayer::bet
+    */
+   double bet() override;
+
+ private:
+   const HandHistory::Seat *seat = nullptr; ///< The recorded seat
+   size_t nextBet = 0;                      ///< Next recorded bet to make
+};
+#endif // REPLAYPOKERPLAYER_H
@@ -53,27 +53,35 @@ const map<char, string> Card::legend = {
 /**
  * @brief Protected constructor for derived Card classes.
  */
-Card::Card() : orientation(FACE_DOWN), rank(' '), suit(' ') {}
-
-Card::Card(ORIENTATION orientation)
-    : orientation(orientation), rank(' '), suit(' ')
-{}
+Card::Card() : rank(' '), suit(' '), id(CardBits::INVALID_ID) {}
 
 Card::Card(string token)
 {
    rank = token.at(0);
    suit = token.at(1);
+   id = CardBits::toId(rank, suit);
 }
 
-Card::Card(string token, ORIENTATION orientation) : Card(token)
+Card::Card(CardId id)
+    : suit(CardBits::SUIT_CHARS[CardBits::getSuit(id)]),
+      rank(CardBits::RANK_CHARS[CardBits::getRank(id)]), id(id)
+{}
+
+const CardPtr &Card::get(CardId id)
 {
-   this->orientation = orientation;
+   static const array<CardPtr, CardBits::DECK_SIZE> deck = [] {
+      array<CardPtr, CardBits::DECK_SIZE> cards;
+      for (int i = 0; i < CardBits::DECK_SIZE; ++i) {
+         cards[i] = make_shared<Card>(static_cast<CardId>(i));
+      }
+      return cards;
+   }();
+   return deck.at(id);
 }
 
 bool Card::isValid() const
 {
-   return find(ranks.begin(), ranks.end(), rank) != ranks.end() &&
-          find(suits.begin(), suits.end(), suit) != suits.end();
+   return id != CardBits::INVALID_ID;
 }
 
 char Card::getSuit() const
@@ -86,10 +94,15 @@ char Card::getRank() const
    return rank;
 }
 
+CardId Card::getId() const
+{
+   return id;
+}
+
 int Card::getValue() const
 {
-   auto it = std::find(ranks.begin(), ranks.end(), rank);
-   return (it != ranks.end()) ? distance(ranks.begin(), it) + 2 : -1;
+   int index = CardBits::toRank(rank);
+   return index < 0 ? -1 : index + 2;
 }
 
 string Card::getName(bool verbose) const
@@ -101,27 +114,19 @@ string Card::getName(bool verbose) const
    }
 }
 
-Card::ORIENTATION Card::getOrientation() const
-{
-   return orientation;
-}
-
-Card::ORIENTATION Card::flip()
+weak_ordering Card::operator<=>(const CardPtr &other) const
 {
-   orientation = orientation == FACE_UP ? FACE_DOWN : FACE_UP;
-   return orientation;
+   return order(rank) <=> order(other->rank);
 }
 
-weak_ordering Card::operator<=>(const CardPtr &other) const
+bool Card::operator==(const CardPtr &other) const
 {
-   auto r = ranks;
-   return distance(r.begin(), find(r.begin(), r.end(), rank)) <=>
-          distance(r.begin(), find(r.begin(), r.end(), other->rank));
+   return order(rank) == order(other->rank);
 }
 
-bool Card::operator==(const CardPtr &other) const
+int Card::order(char rank)
 {
-   auto r = ranks;
-   return distance(r.begin(), find(r.begin(), r.end(), rank)) ==
-          distance(r.begin(), find(r.begin(), r.end(), other->rank));
+   ///< Unknown ranks sort after aces, as they did with a linear search
+   unsigned index = CardBits::toRank(rank);
+   return min(index, unsigned(CardBits::RANK_COUNT));
 }
@@ -5,6 +5,7 @@
 #ifndef CARD_H
 #define CARD_H
 
+#include "CardBits.h"
 #include <compare>
 #include <map>
 #include <memory>
@@ -14,6 +15,10 @@
 /**
  * @class Card
  * @brief This class represents a Poker Card.
+ *
+ * Cards are immutable. Card::get returns one of 52 canonical cards shared by
+ * the whole process, so decks and hands hold references instead of copies.
+ * Whether a card is face up is state of the collection holding it.
  */
 class Card
 {
@@ -35,12 +40,20 @@ class Card
    Card(std::string token);
 
    /**
-    * @brief Overloaded Constructor for Card.
+    * @brief Constructs a Card from its compact id.
     *
-    * @param token card token value.
-    * @param orientation card orientation.
+    * @param id card id, from 0 to 51.
+    */
+   explicit Card(CardId id);
+
+   /**
+    * @brief Returns the canonical card with an id.
+    *
+    * @param id card id, from 0 to 51.
+    * @return const std::shared_ptr<Card>& the shared card.
+    * @throw std::out_of_range if the id is not a card id.
     */
-   Card(std::string token, ORIENTATION orientation);
+   static const std::shared_ptr<Card> &get(CardId id);
 
    /**
     * @brief Checks if the card is valid.
@@ -66,6 +79,12 @@ class Card
     */
    int getValue() const;
 
+   /**
+    * @brief Returns the compact card id.
+    * @return CardId card id, or CardBits::INVALID_ID for an invalid card.
+    */
+   CardId getId() const;
+
    /**
     * @brief Returns the card suit and rank.
     *
@@ -74,18 +93,6 @@ class Card
     */
    virtual std::string getName(bool verbose = false) const;
 
-   /**
-    * @brief Gets the orientation of the card.
-    * @return The orientation of the card.
-    */
-   ORIENTATION getOrientation() const;
-
-   /**
-    * @brief Toggles the orientation of the card.
-    * @param ORIENTATION orientation The new orientation of the card.
-    */
-   virtual ORIENTATION flip();
-
    /**
     * @brief Overloads the spaceship operator for rank comparison.
     *
@@ -104,24 +111,25 @@ class Card
    virtual bool operator==(const std::shared_ptr<Card> &other) const;
 
  protected:
-   ORIENTATION orientation; ///< Carc orientation.
-
    /**
     * @brief Default Constructor for Derived Card.
     */
    Card();
 
-   /**
-    * @brief Overloaded Constructor for Derived classes.
-    * @param ORIENTATION orientation The orientation of the card.
-    */
-   Card(const ORIENTATION orientation = FACE_DOWN);
-
  private:
    static const std::map<char, std::string> legend; ///< Display Names.
    bool valid;                                      ///< Card Validity.
    char suit;                                       ///< Card Suit.
    char rank;                                       ///< Card Rank.
+   CardId id;                                       ///< Card Id.
+
+   /**
+    * @brief Returns the comparison order of a rank character.
+    *
+    * @param rank card rank.
+    * @return int rank index, or 13 for an unknown rank.
+    */
+   static int order(char rank);
 };
 
 #endif // CARD_H
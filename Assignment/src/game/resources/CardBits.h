@@ -0,0 +1,298 @@
+/**
+ * @file src/game/resources/CardBits.h
+ * @brief Defines compact value representations for cards and card sets.
+ */
+#ifndef CARDBITS_H
+#define CARDBITS_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+using CardId = std::uint8_t;    ///< Card index, suit * 13 + rank, 0..51.
+using CardMask = std::uint64_t; ///< Set of cards, one bit per CardId.
+
+/**
+ * @class CardBits
+ * @brief Bit operations on CardId and CardMask values.
+ *
+ * A CardId numbers the deck suit by suit in Card::suits order, and rank by
+ * rank in Card::ranks order within each suit, so each suit occupies a
+ * contiguous 13-bit field of a CardMask.
+ *
+ * Rank and suit characters convert to and from indices through constexpr
+ * tables, so the conversions are O(1) and never allocate.
+ *
+ * Sets of up to five cards are numbered densely by the combinatorial number
+ * system in colex order: a set of k cards with ids c1 < ... < ck has index
+ * C(c1, 1) + ... + C(ck, k). Colex order is the numeric order of CardMasks,
+ * so the 2,598,960 five card hands have indices 0 .. 2,598,959 in the order
+ * of their masks, and an index fits in 22 bits.
+ */
+class CardBits
+{
+ public:
+   static constexpr int RANK_COUNT = 13;          ///< Ranks per suit.
+   static constexpr int SUIT_COUNT = 4;           ///< Suits per deck.
+   static constexpr int DECK_SIZE = 52;           ///< Cards per deck.
+   static constexpr CardId INVALID_ID = 0xFF;     ///< Id of an invalid card.
+   static constexpr unsigned RANK_FIELD = 0x1FFF; ///< One suit's rank bits.
+   static constexpr CardMask FULL_DECK = (CardMask{1} << DECK_SIZE) - 1;
+   static constexpr int MAX_COMBINATION = 5;      ///< Most cards indexed.
+   static constexpr std::uint32_t HAND_COMBINATIONS = 2598960; ///< C(52, 5)
+   static constexpr std::uint32_t INVALID_COMBINATION = UINT32_MAX; ///< None
+   static constexpr char RANK_CHARS[] = "23456789TJQKA"; ///< By rank index.
+   static constexpr char SUIT_CHARS[] = "CDHS";          ///< By suit index.
+
+   /**
+    * @brief Rank index of each character, or -1 if it is not a rank.
+    */
+   static constexpr std::array<std::int8_t, 256> RANK_INDEX = [] {
+      std::array<std::int8_t, 256> index{};
+      index.fill(-1);
+      for (int rank = 0; rank < RANK_COUNT; ++rank) {
+         index[static_cast<unsigned char>(RANK_CHARS[rank])] = rank;
+      }
+      return index;
+   }();
+
+   /**
+    * @brief Suit index of each character, or -1 if it is not a suit.
+    */
+   static constexpr std::array<std::int8_t, 256> SUIT_INDEX = [] {
+      std::array<std::int8_t, 256> index{};
+      index.fill(-1);
+      for (int suit = 0; suit < SUIT_COUNT; ++suit) {
+         index[static_cast<unsigned char>(SUIT_CHARS[suit])] = suit;
+      }
+      return index;
+   }();
+
+   /**
+    * @brief C(n, k) for k up to MAX_COMBINATION, indexed [k][n].
+    * @details Entries past n = 52 hold UINT32_MAX, so searches over a row
+    * can step a fixed 64 entries without bounds checks.
+    */
+   static constexpr std::array<std::array<std::uint32_t, 64>, 6> CHOOSE = [] {
+      std::array<std::array<std::uint32_t, 64>, 6> choose{};
+      for (int n = 0; n < 64; ++n) {
+         for (int k = 0; k <= MAX_COMBINATION; ++k) {
+            if (n > DECK_SIZE) {
+               choose[k][n] = UINT32_MAX;
+            } else if (k == 0) {
+               choose[k][n] = 1;
+            } else if (n > 0) {
+               choose[k][n] = choose[k - 1][n - 1] + choose[k][n - 1];
+            }
+         }
+      }
+      return choose;
+   }();
+
+   /**
+    * @brief Returns the index of a set among the sets of as many cards.
+    *
+    * @param mask The card set, of at most MAX_COMBINATION cards.
+    * @return std::uint32_t The colex index, from 0 to C(52, k) - 1 for a
+    * set of k cards, or INVALID_COMBINATION for a larger set or one with
+    * bits past the deck.
+    */
+   static constexpr std::uint32_t rankCombination(CardMask mask)
+   {
+      if (count(mask) > MAX_COMBINATION || (mask & ~FULL_DECK)) {
+         return INVALID_COMBINATION;
+      }
+      std::uint32_t index = 0;
+      for (int k = 1; mask; ++k) {
+         index += CHOOSE[k][popLowest(mask)];
+      }
+      return index;
+   }
+
+   /**
+    * @brief Returns the set of cards with an index.
+    * @details Each card is found by a fixed six step search of its row of
+    * CHOOSE, so the search does not branch on the index.
+    *
+    * @param index The colex index.
+    * @param cards The number of cards, at most MAX_COMBINATION.
+    * @return CardMask The set, or 0 if the index is out of range.
+    */
+   static constexpr CardMask unrankCombination(
+       std::uint32_t index, int cards = MAX_COMBINATION
+   )
+   {
+      if (cards < 0 || cards > MAX_COMBINATION ||
+          index >= CHOOSE[cards][DECK_SIZE]) {
+         return 0;
+      }
+      CardMask mask = 0;
+      for (int k = cards; k > 0; --k) {
+         unsigned id = 0;
+         for (unsigned step = 32; step > 0; step >>= 1) {
+            id += (CHOOSE[k][id + step] <= index) * step;
+         }
+         mask |= toMask(static_cast<CardId>(id));
+         index -= CHOOSE[k][id];
+      }
+      return mask;
+   }
+
+   /**
+    * @brief Returns the next larger set with as many cards.
+    * @details Gosper's hack: the lowest run of cards moves its top card up
+    * one place and the rest of the run down to the bottom. Walking from
+    * the lowest set of k cards visits every set of k cards in colex order.
+    *
+    * @param mask A nonempty card set.
+    * @return CardMask The next set, past FULL_DECK after the highest set.
+    */
+   static constexpr CardMask nextCombination(CardMask mask)
+   {
+      CardMask lowest = mask & -mask;
+      CardMask ripple = mask + lowest;
+      return ripple | (((mask ^ ripple) >> 2) / lowest);
+   }
+
+   /**
+    * @brief Returns the rank index of a rank character.
+    *
+    * @param rank The rank character, e.g. 'T'.
+    * @return int The rank index, from 0 (deuce) to 12 (ace), or -1.
+    */
+   static constexpr int toRank(char rank)
+   {
+      return RANK_INDEX[static_cast<unsigned char>(rank)];
+   }
+
+   /**
+    * @brief Returns the suit index of a suit character.
+    *
+    * @param suit The suit character, e.g. 'S'.
+    * @return int The suit index, from 0 to 3, or -1.
+    */
+   static constexpr int toSuit(char suit)
+   {
+      return SUIT_INDEX[static_cast<unsigned char>(suit)];
+   }
+
+   /**
+    * @brief Returns the id of a card given by its characters.
+    *
+    * @param rank The rank character.
+    * @param suit The suit character.
+    * @return CardId The card id, or INVALID_ID if either character is invalid.
+    */
+   static constexpr CardId toId(char rank, char suit)
+   {
+      int r = toRank(rank), s = toSuit(suit);
+      return (r | s) < 0 ? INVALID_ID : makeId(r, s);
+   }
+
+   /**
+    * @brief Returns the id of a card.
+    *
+    * @param rank The rank index, from 0 (deuce) to 12 (ace).
+    * @param suit The suit index, from 0 to 3.
+    * @return CardId
+    */
+   static constexpr CardId makeId(int rank, int suit)
+   {
+      return static_cast<CardId>(suit * RANK_COUNT + rank);
+   }
+
+   /**
+    * @brief Returns the rank index of a card id.
+    *
+    * @param id The card id.
+    * @return int The rank index, from 0 (deuce) to 12 (ace).
+    */
+   static constexpr int getRank(CardId id)
+   {
+      return id % RANK_COUNT;
+   }
+
+   /**
+    * @brief Returns the suit index of a card id.
+    *
+    * @param id The card id.
+    * @return int The suit index, from 0 to 3.
+    */
+   static constexpr int getSuit(CardId id)
+   {
+      return id / RANK_COUNT;
+   }
+
+   /**
+    * @brief Returns the single card mask of a card id.
+    *
+    * @param id The card id.
+    * @return CardMask
+    */
+   static constexpr CardMask toMask(CardId id)
+   {
+      return CardMask{1} << id;
+   }
+
+   /**
+    * @brief Checks whether a mask contains a card.
+    *
+    * @param mask The card set.
+    * @param id The card id.
+    * @return true if the card is in the set, false otherwise.
+    */
+   static constexpr bool contains(CardMask mask, CardId id)
+   {
+      return (mask >> id) & 1;
+   }
+
+   /**
+    * @brief Returns the number of cards in a mask.
+    *
+    * @param mask The card set.
+    * @return int
+    */
+   static constexpr int count(CardMask mask)
+   {
+      return std::popcount(mask);
+   }
+
+   /**
+    * @brief Removes and returns the lowest card of a non-empty mask.
+    *
+    * @param mask The card set, updated in place.
+    * @return CardId
+    */
+   static constexpr CardId popLowest(CardMask &mask)
+   {
+      CardId id = static_cast<CardId>(std::countr_zero(mask));
+      mask &= mask - 1;
+      return id;
+   }
+
+   /**
+    * @brief Returns the 13-bit rank set held in one suit of a mask.
+    *
+    * @param mask The card set.
+    * @param suit The suit index, from 0 to 3.
+    * @return unsigned Bit n is set if rank index n is held in the suit.
+    */
+   static constexpr unsigned getSuitRanks(CardMask mask, int suit)
+   {
+      return static_cast<unsigned>(mask >> (suit * RANK_COUNT)) & RANK_FIELD;
+   }
+
+   /**
+    * @brief Returns the 13-bit set of ranks held in any suit of a mask.
+    *
+    * @param mask The card set.
+    * @return unsigned Bit n is set if rank index n is held.
+    */
+   static constexpr unsigned getRanks(CardMask mask)
+   {
+      return getSuitRanks(mask, 0) | getSuitRanks(mask, 1) |
+             getSuitRanks(mask, 2) | getSuitRanks(mask, 3);
+   }
+};
+
+#endif // CARDBITS_H
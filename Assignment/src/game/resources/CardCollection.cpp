@@ -10,9 +10,20 @@
 using namespace std;
 using CardPtr = shared_ptr<Card>;
 
-CardCollection::CardCollection() : cards(vector<CardPtr>()) {}
+CardCollection::CardCollection() : cards(vector<CardPtr>()), faceUp(0) {}
 
-CardCollection::CardCollection(vector<CardPtr> cards_v) : cards(cards_v) {}
+CardCollection::CardCollection(vector<CardPtr> cards_v)
+    : cards(cards_v), faceUp(0)
+{}
+
+CardCollection::CardCollection(CardMask mask)
+    : cards(vector<CardPtr>()), faceUp(0)
+{
+   cards.reserve(CardBits::count(mask));
+   while (mask) {
+      cards.push_back(Card::get(CardBits::popLowest(mask)));
+   }
+}
 
 void CardCollection::add(const CardPtr &card)
 {
@@ -20,11 +31,27 @@ void CardCollection::add(const CardPtr &card)
    cards.push_back(card);
 }
 
+void CardCollection::add(const CardPtr &card, Card::ORIENTATION orientation)
+{
+   add(card);
+   setOrientation(card->getId(), orientation);
+}
+
 void CardCollection::remove(const CardPtr &card)
 {
    Logger::trace("Removing card: " + card->getName(true) + " from collection.");
    auto itr = std::remove(cards.begin(), cards.end(), card);
    cards.erase(itr, cards.end());
+   setOrientation(card->getId(), Card::FACE_DOWN);
+}
+
+void CardCollection::removeCards(CardMask mask)
+{
+   faceUp &= ~mask;
+   auto itr = std::remove_if(cards.begin(), cards.end(), [mask](auto &card) {
+      return card->isValid() && CardBits::contains(mask, card->getId());
+   });
+   cards.erase(itr, cards.end());
 }
 
 CardPtr CardCollection::get(int idx) const
@@ -42,12 +69,47 @@ bool CardCollection::isEmpty() const
    return cards.empty();
 }
 
+CardMask CardCollection::getMask() const
+{
+   CardMask mask = 0;
+   for (const auto &card : cards) {
+      if (card->isValid()) {
+         mask |= CardBits::toMask(card->getId());
+      }
+   }
+   return mask;
+}
+
+bool CardCollection::contains(CardId id) const
+{
+   return id < CardBits::DECK_SIZE && CardBits::contains(getMask(), id);
+}
+
+Card::ORIENTATION CardCollection::getOrientation(CardId id) const
+{
+   return id < CardBits::DECK_SIZE && CardBits::contains(faceUp, id)
+              ? Card::FACE_UP
+              : Card::FACE_DOWN;
+}
+
+void CardCollection::setOrientation(CardId id, Card::ORIENTATION orientation)
+{
+   if (id >= CardBits::DECK_SIZE) {
+      return;
+   }
+   if (orientation == Card::FACE_UP) {
+      faceUp |= CardBits::toMask(id);
+   } else {
+      faceUp &= ~CardBits::toMask(id);
+   }
+}
+
 vector<string> CardCollection::getCardNames(bool verbose) const
 {
    vector<string> cardNames;
-   cardNames.reserve(cards.size());
-   for (const auto &cardPtr : cards) {
-      cardNames.push_back(cardPtr->getName(verbose));
+   cardNames.reserve(size());
+   for (size_t i = 0; i < size(); ++i) {
+      cardNames.push_back(get(i)->getName(verbose));
    }
    return cardNames;
 }
@@ -56,10 +118,10 @@ string CardCollection::getCardsDescription(bool verbose) const
 {
    string delimiter = " | ";
    string description = "";
-   if (!cards.empty()) {
+   if (!isEmpty()) {
       description += delimiter;
-      for (const auto &cardPtr : cards) {
-         description += cardPtr->getName(verbose) + delimiter;
+      for (size_t i = 0; i < size(); ++i) {
+         description += get(i)->getName(verbose) + delimiter;
       }
    }
    return description;
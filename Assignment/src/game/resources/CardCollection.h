@@ -6,6 +6,7 @@
 #define CARD_COLLECTION_H
 
 #include "Card.h"
+#include "CardBits.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -15,7 +16,8 @@
  * @brief Base class for a collection of cards.
  *
  * This class provides a common set of basic operations for managing a
- * collection of cards.
+ * collection of cards. The collection also records which of its cards are
+ * face up, since the cards themselves are shared and immutable.
  */
 class CardCollection
 {
@@ -32,6 +34,13 @@ class CardCollection
     */
    CardCollection(std::vector<std::shared_ptr<Card>> cards_v);
 
+   /**
+    * @brief Construct from a card mask, in ascending CardId order.
+    *
+    * @param mask The set of cards.
+    */
+   explicit CardCollection(CardMask mask);
+
    /**
     * @brief Default destructor for the CardCollection class.
     */
@@ -43,6 +52,13 @@ class CardCollection
     */
    virtual void add(const std::shared_ptr<Card> &card);
 
+   /**
+    * @brief Adds a card to the collection with an orientation.
+    * @param card Pointer to the card to add.
+    * @param orientation Orientation of the card in this collection.
+    */
+   void add(const std::shared_ptr<Card> &card, Card::ORIENTATION orientation);
+
    /**
     * @brief Removes a card from the collection.
     * @param card Pointer to the card to remove.
@@ -51,6 +67,12 @@ class CardCollection
     */
    virtual void remove(const std::shared_ptr<Card> &card);
 
+   /**
+    * @brief Removes every card in a mask from the collection.
+    * @param mask The set of cards to remove.
+    */
+   virtual void removeCards(CardMask mask);
+
    /**
     * @brief Returns a card from the collection by index.
     * @param index Index of the card.
@@ -70,6 +92,33 @@ class CardCollection
     */
    virtual bool isEmpty() const;
 
+   /**
+    * @brief Returns the set of valid cards in the collection.
+    * @return CardMask with one bit per card.
+    */
+   virtual CardMask getMask() const;
+
+   /**
+    * @brief Checks if the collection holds a card.
+    * @param id The card id.
+    * @return True if the card is in the collection, false otherwise.
+    */
+   virtual bool contains(CardId id) const;
+
+   /**
+    * @brief Returns the orientation of a card in the collection.
+    * @param id The card id.
+    * @return Card::ORIENTATION FACE_UP if the card was turned up.
+    */
+   Card::ORIENTATION getOrientation(CardId id) const;
+
+   /**
+    * @brief Sets the orientation of a card in the collection.
+    * @param id The card id.
+    * @param orientation The new orientation.
+    */
+   void setOrientation(CardId id, Card::ORIENTATION orientation);
+
    /**
     * @brief Retrieves all card names in the collection.
     * @param verbose Flag to indicate if full names should be returned.
@@ -87,6 +136,7 @@ class CardCollection
 
  protected:
    std::vector<std::shared_ptr<Card>> cards; ///< Collection Card vector
+   CardMask faceUp;                          ///< Cards turned face up
 };
 
 #endif // CARD_COLLECTION_H
@@ -6,18 +6,47 @@
 #include "Deck.h"
 #include "../../../utils/Logger.h"
 #include <algorithm>
-#include <ctime>
+#include <array>
 #include <random>
+#include <stdexcept>
 
 using namespace std;
 using CardPtr = shared_ptr<Card>;
 
-Deck::Deck() : CardCollection()
+namespace
+{
+/**
+ * @brief Every card id, in new deck order.
+ */
+constexpr auto NEW_DECK = [] {
+   array<CardId, CardBits::DECK_SIZE> ids{};
+   for (int i = 0; i < CardBits::DECK_SIZE; ++i) {
+      ids[i] = static_cast<CardId>(i);
+   }
+   return ids;
+}();
+
+/**
+ * @brief Returns a fresh seed for a new deck.
+ * @details Only the first deck on each thread reads the random device,
+ * which is a system call, and later decks continue its generator.
+ */
+uint64_t freshSeed()
+{
+   thread_local Xoshiro256 seeds = [] {
+      random_device device;
+      return Xoshiro256(uint64_t(device()) << 32 | device());
+   }();
+   return seeds();
+}
+} // namespace
+
+Deck::Deck() : CardCollection(), rng(freshSeed())
 {
    reset();
 }
 
-Deck::Deck(bool empty) : CardCollection()
+Deck::Deck(bool empty) : CardCollection(), rng(freshSeed())
 {
    if (!empty) {
       reset();
@@ -26,40 +55,150 @@ Deck::Deck(bool empty) : CardCollection()
 
 void Deck::reset()
 {
-   cards.clear();
-   for (auto &suit : Card::suits) {
-      for (auto &rank : Card::ranks) {
-         cards.push_back(make_shared<Card>(string(1, rank) + suit));
-      }
-   }
+   ids = NEW_DECK;
+   top = CardBits::DECK_SIZE;
+   mask = CardBits::FULL_DECK;
+   faceUp = 0;
+}
+
+void Deck::clear()
+{
+   top = 0;
+   mask = 0;
+   faceUp = 0;
+}
+
+void Deck::seed(uint64_t seed)
+{
+   rng = Xoshiro256(seed);
 }
 
 void Deck::shuffle()
+{
+   shuffle(size());
+}
+
+void Deck::shuffle(size_t count)
 {
    size_t n = size();
    if (n == 0) {
       Logger::warn("Cannot shuffle an empty deck.");
       return;
    }
-   default_random_engine engine{random_device{}()}; ///< random generator
-   uniform_int_distribution<size_t> distribution{0, n - 1}; ///< range[0, n-1]
-   Logger::trace("Distribution of size: " + to_string(n) + " computed.");
-   for (size_t i = n; i-- > 0;) {
-      swap(cards[i], cards[distribution(engine)]); ///< swap random idx cards
+   count = min(count, n - 1); ///< The last card has nowhere to go
+   for (size_t i = n - 1; i > n - 1 - count; --i) {
+      ///< Swap the top unshuffled card with one of the cards at or below it
+      swap(ids[i], ids[rng.bounded(static_cast<uint32_t>(i + 1))]);
+   }
+   Logger::trace(to_string(count) + " cards swapped.");
+}
+
+size_t Deck::stack(const CardId *order, size_t count)
+{
+   count = min(count, size());
+   for (size_t i = 0; i < count; ++i) {
+      ///< Swap the card into the next slot down from the top
+      auto slot = ids.begin() + (top - 1 - i);
+      auto card = find(ids.begin(), slot + 1, order[i]);
+      if (card > slot) {
+         return i; ///< Not held, or already stacked
+      }
+      swap(*card, *slot);
    }
-   Logger::trace(to_string(n) + " cards swapped.");
+   return count;
 }
 
-CardPtr Deck::deal(Card::ORIENTATION orientation)
+CardPtr Deck::deal()
 {
    if (isEmpty()) {
       return nullptr;
    }
-   CardPtr card = cards.back(); ///< Last card in deck.
-   if (card->getOrientation() != orientation) {
-      card->flip();
+   CardId id = ids[--top];
+   mask &= ~CardBits::toMask(id);
+   return Card::get(id);
+}
+
+CardId Deck::burn()
+{
+   if (isEmpty()) {
+      return CardBits::INVALID_ID;
    }
-   remove(card);
-   Logger::trace("Dealt card from deck: " + card->getName(true) + ".");
-   return card;
+   CardId id = ids[--top];
+   mask &= ~CardBits::toMask(id);
+   faceUp &= ~CardBits::toMask(id);
+   return id;
+}
+
+void Deck::recycle(Deck &discards)
+{
+   discards.removeCards(mask);
+   int count = discards.top;
+   ///< Slide the remaining cards up and slot the discards in beneath them
+   copy_backward(ids.begin(), ids.begin() + top, ids.begin() + top + count);
+   copy(discards.ids.begin(), discards.ids.begin() + count, ids.begin());
+   top += count;
+   mask |= discards.mask;
+   discards.clear();
+}
+
+void Deck::add(const CardPtr &card)
+{
+   if (!card->isValid()) {
+      Logger::warn("Cannot add invalid card " + card->getName() + " to deck.");
+      return;
+   }
+   if (CardBits::contains(mask, card->getId())) {
+      Logger::warn("Cannot add " + card->getName() + " to deck twice.");
+      return;
+   }
+   ids[top++] = card->getId();
+   mask |= CardBits::toMask(card->getId());
+}
+
+void Deck::remove(const CardPtr &card)
+{
+   Logger::trace("Removing card: " + card->getName(true) + " from deck.");
+   removeCards(CardBits::toMask(card->getId()));
+   setOrientation(card->getId(), Card::FACE_DOWN);
+}
+
+void Deck::removeCards(CardMask removed)
+{
+   if (mask & removed) {
+      auto end = std::remove_if(
+          ids.begin(), ids.begin() + top,
+          [removed](CardId id) { return CardBits::contains(removed, id); }
+      );
+      top = static_cast<int>(end - ids.begin());
+      mask &= ~removed;
+   }
+   faceUp &= ~removed;
+}
+
+CardId Deck::getId(int index) const
+{
+   if (index < 0 || index >= top) {
+      throw out_of_range("Deck index " + to_string(index) + " out of range.");
+   }
+   return ids[index];
+}
+
+CardPtr Deck::get(int index) const
+{
+   return Card::get(getId(index));
+}
+
+size_t Deck::size() const
+{
+   return top;
+}
+
+bool Deck::isEmpty() const
+{
+   return top == 0;
+}
+
+CardMask Deck::getMask() const
+{
+   return mask;
 }
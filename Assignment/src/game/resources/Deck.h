@@ -6,16 +6,25 @@
 #ifndef DECK_H
 #define DECK_H
 
+#include "../../../utils/Random.h"
 #include "CardCollection.h"
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <vector>
 
 class Card; ///< Forward declaration of Card class
 
 /**
  * @class Deck
  * @brief Represents a deck of cards.
+ *
+ * A deck holds the ids of its cards in a fixed 52 slot array, top card
+ * last, and hands out the canonical Card objects from Card::get. Building
+ * or resetting a deck only copies ids, and dealing, burning and returning
+ * cards cost a constant amount per card.
+ * Each deck owns a small generator for its shuffles. It is seeded once when
+ * the deck is built, or explicitly to replay the same shuffles.
  */
 class Deck : public CardCollection
 {
@@ -36,18 +45,119 @@ class Deck : public CardCollection
     */
    void reset();
 
+   /**
+    * @brief Removes every card from the deck.
+    */
+   void clear();
+
+   /**
+    * @brief Seeds the shuffle generator.
+    * @details Decks with the same seed and contents shuffle identically.
+    *
+    * @param seed The seed.
+    */
+   void seed(std::uint64_t seed);
+
    /**
     * @brief Shuffles the deck of cards using the Knuth shuffle algorithm.
     * @link https://en.wikipedia.org/wiki/Fisher%E2%80%93Yates_shuffle
     */
    void shuffle();
 
+   /**
+    * @brief Shuffles only the cards about to be dealt.
+    * @details Runs the first count steps of the Knuth shuffle from the top,
+    * so the top count cards are a uniform random draw from the whole deck,
+    * in random order. The cards below them are left partly shuffled, so
+    * deal no more than count cards before shuffling again.
+    *
+    * @param count The number of cards to shuffle onto the top.
+    */
+   void shuffle(size_t count);
+
+   /**
+    * @brief Arranges the deck so given cards are dealt next, in order.
+    * @details Replays a recorded deal in place of a shuffle. Stops at the
+    * first card the deck does not hold or has already stacked. The cards
+    * below the stacked ones are left in no particular order.
+    *
+    * @param order The card ids, first to be dealt first.
+    * @param count The number of ids.
+    * @return size_t The number of cards stacked.
+    */
+   size_t stack(const CardId *order, size_t count);
+
    /**
     * @brief Deals a card from the deck.
-    * @param orientation Orientation of the card dealt.
-    * @return std::shared_ptr<Card> to the card dealt.
+    * @return std::shared_ptr<Card> to the card dealt, or nullptr if empty.
+    */
+   std::shared_ptr<Card> deal();
+
+   /**
+    * @brief Discards the top card without dealing it.
+    * @return CardId The id of the card burned, or CardBits::INVALID_ID if
+    * the deck is empty.
     */
-   std::shared_ptr<Card>
-   deal(Card::ORIENTATION orientation = Card::ORIENTATION::FACE_DOWN);
+   CardId burn();
+
+   /**
+    * @brief Returns every card of another deck under this one.
+    * @details Moves the cards in one block and empties the other deck, so
+    * discards go back without being dealt one at a time. Cards this deck
+    * already holds are dropped from the other deck.
+    *
+    * @param discards The deck to empty into this one.
+    */
+   void recycle(Deck &discards);
+
+   /**
+    * @brief Returns the id of a card without touching the Card itself.
+    *
+    * @param index The position, counted from the bottom of the deck.
+    * @return CardId The id of the card at that position.
+    */
+   CardId getId(int index) const;
+
+   /**
+    * @see CardCollection::add
+    */
+   void add(const std::shared_ptr<Card> &card) override;
+   using CardCollection::add;
+
+   /**
+    * @see CardCollection::remove
+    */
+   void remove(const std::shared_ptr<Card> &card) override;
+
+   /**
+    * @see CardCollection::removeCards
+    */
+   void removeCards(CardMask mask) override;
+
+   /**
+    * @see CardCollection::get
+    */
+   std::shared_ptr<Card> get(int index) const override;
+
+   /**
+    * @see CardCollection::size
+    */
+   size_t size() const override;
+
+   /**
+    * @see CardCollection::isEmpty
+    */
+   bool isEmpty() const override;
+
+   /**
+    * @see CardCollection::getMask
+    */
+   CardMask getMask() const override;
+
+ private:
+   std::array<CardId, CardBits::DECK_SIZE> ids; ///< Cards, top card last
+   int top = 0;                                 ///< Number of cards held
+   CardMask mask = 0;                           ///< Cards held
+   Xoshiro256 rng;                              ///< Shuffle generator
 };
-#endif // DECK_H
\ No newline at end of file
+#endif // DECK_H
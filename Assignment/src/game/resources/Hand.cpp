@@ -43,11 +43,27 @@ void Hand::remove(const CardPtr &card)
    *this -= card;
 }
 
+void Hand::removeCards(CardMask mask)
+{
+   CardCollection::removeCards(mask);
+   process();
+}
+
+void Hand::added([[maybe_unused]] const CardPtr &card)
+{
+   process();
+}
+
+void Hand::removed([[maybe_unused]] const CardPtr &card)
+{
+   process();
+}
+
 HandPtr Hand::operator+=(const CardPtr &card)
 {
    Logger::trace("Adding card: " + card->getName(true) + " to collection.");
    cards.push_back(card);
-   process();
+   added(card);
    return shared_from_this();
 }
 
@@ -55,7 +71,11 @@ HandPtr Hand::operator-=(const CardPtr &card)
 {
    Logger::trace("Removing card: " + card->getName(true) + " from collection.");
    auto itr = std::remove(cards.begin(), cards.end(), card);
+   size_t erased = distance(itr, cards.end());
    cards.erase(itr, cards.end());
-   process();
+   setOrientation(card->getId(), Card::FACE_DOWN);
+   for (; erased > 0; --erased) {
+      removed(card);
+   }
    return shared_from_this();
 }
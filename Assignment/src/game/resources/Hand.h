@@ -65,12 +65,18 @@ class Hand : public CardCollection, public std::enable_shared_from_this<Hand>
     * @see CardCollection::add
     */
    void add(const std::shared_ptr<Card> &card) override;
+   using CardCollection::add;
 
    /**
     * @see CardCollection::remove
     */
    void remove(const std::shared_ptr<Card> &card) override;
 
+   /**
+    * @see CardCollection::removeCards
+    */
+   void removeCards(CardMask mask) override;
+
    /**
     * @brief Computes the score of the hand.
     * @return The score of the hand as a long long.
@@ -150,6 +156,24 @@ class Hand : public CardCollection, public std::enable_shared_from_this<Hand>
     */
    virtual void process() = 0;
 
+   /**
+    * @brief Updates the hand after a card is appended to its cards.
+    *
+    * The default implementation processes the whole hand again.
+    *
+    * @param card Pointer to the card added.
+    */
+   virtual void added(const std::shared_ptr<Card> &card);
+
+   /**
+    * @brief Updates the hand after a card is erased from its cards.
+    *
+    * The default implementation processes the whole hand again.
+    *
+    * @param card Pointer to the card removed.
+    */
+   virtual void removed(const std::shared_ptr<Card> &card);
+
    /**
     * @brief Computes the score and category of the hand.
     */
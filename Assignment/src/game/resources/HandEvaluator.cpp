@@ -0,0 +1,380 @@
+/**
+ * @file src/game/resources/HandEvaluator.cpp
+ * @brief Implementation of the HandEvaluator class.
+ */
+#include "HandEvaluator.h"
+#include "Card.h"
+#include "HandEvaluatorTables.h"
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using Category = PokerHand::Category;
+
+namespace
+{
+constexpr int MASK_SIZE = HandEvaluator::Tables::MASK_SIZE;
+constexpr int PAIRED_COUNT = HandEvaluator::Tables::PAIRED_COUNT;
+constexpr int PAIR_SETS = HandEvaluator::Tables::PAIR_SETS;
+constexpr int TRIPLE_SETS = HandEvaluator::Tables::TRIPLE_SETS;
+constexpr uint32_t PRIMES[HandEvaluator::RANK_COUNT] = {
+    2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41
+};
+constexpr unsigned WHEEL = 0x100F; ///< A-5-4-3-2 rank bitmask.
+constexpr unsigned STRAIGHTS[10] = {
+    0x1F00, 0x0F80, 0x07C0, 0x03E0, 0x01F0, 0x00F8, 0x007C, 0x003E, 0x001F,
+    WHEEL
+}; ///< Straight rank bitmasks, best first.
+
+/**
+ * @brief Describes one equivalence class during table generation.
+ */
+struct HandClass
+{
+   Category category;
+   unsigned long long tiebreak; ///< Ranks by count then value, 4 bits each.
+   unsigned mask;               ///< Rank bitmask.
+   uint32_t product;            ///< Product of rank primes.
+};
+
+/**
+ * @brief Returns the top rank index of a straight, or -1 if not a straight.
+ */
+int straightTop(unsigned mask)
+{
+   if (mask == WHEEL) {
+      return 3; ///< The wheel plays as a five high straight
+   }
+   for (int top = HandEvaluator::RANK_COUNT - 1; top >= 4; --top) {
+      if (mask == (0x1Fu << (top - 4))) {
+         return top;
+      }
+   }
+   return -1;
+}
+
+/**
+ * @brief Advances a non-decreasing rank sequence to the next multiset.
+ *
+ * @return false once every multiset has been visited.
+ */
+bool nextMultiset(int (&r)[5])
+{
+   int i = 4;
+   while (i >= 0 && r[i] == HandEvaluator::RANK_COUNT - 1) {
+      --i;
+   }
+   if (i < 0) {
+      return false;
+   }
+   for (int value = r[i] + 1; i < 5; ++i) {
+      r[i] = value;
+   }
+   return true;
+}
+
+/**
+ * @brief Returns the index of the highest rank in a bitmask.
+ */
+inline int topRank(unsigned mask)
+{
+   return std::bit_width(mask) - 1;
+}
+
+/**
+ * @brief Clears all but the n highest ranks of a bitmask.
+ */
+inline unsigned keepHighest(unsigned mask, int n)
+{
+   while (std::popcount(mask) > n) {
+      mask &= mask - 1;
+   }
+   return mask;
+}
+
+/**
+ * @brief Clears the n lowest ranks of a bitmask.
+ */
+inline unsigned dropLowest(unsigned mask, int n)
+{
+   for (; n > 0; --n) {
+      mask &= mask - 1;
+   }
+   return mask;
+}
+
+/**
+ * @brief Returns n choose k for small arguments.
+ */
+int choose(int n, int k)
+{
+   if (k < 0 || k > n) {
+      return 0;
+   }
+   int result = 1;
+   for (int i = 1; i <= k; ++i) {
+      result = result * (n - k + i) / i;
+   }
+   return result;
+}
+} // namespace
+
+HandEvaluator::Tables::Tables()
+{
+   vector<HandClass> classes;
+   classes.reserve(CLASS_COUNT);
+
+   ///< Visit every multiset of five ranks as a non-decreasing sequence
+   int r[5] = {0, 0, 0, 0, 0};
+   do {
+      int counts[RANK_COUNT] = {0};
+      unsigned mask = 0;
+      uint32_t product = 1;
+      for (int rank : r) {
+         counts[rank]++;
+         mask |= 1u << rank;
+         product *= PRIMES[rank];
+      }
+
+      ///< Order ranks by count, then value, to break ties within a category
+      vector<pair<int, int>> groups;
+      for (int rank = RANK_COUNT - 1; rank >= 0; --rank) {
+         if (counts[rank] > 0) {
+            groups.emplace_back(counts[rank], rank);
+         }
+      }
+      stable_sort(groups.begin(), groups.end(), [](auto &a, auto &b) {
+         return a.first > b.first;
+      });
+      if (groups.front().first == 5) {
+         continue; ///< Five of a kind needs more than one deck
+      }
+      unsigned long long tiebreak = 0;
+      for (auto &group : groups) {
+         tiebreak = (tiebreak << 4) | group.second;
+      }
+
+      if (groups.size() == 5) {
+         int top = straightTop(mask);
+         if (top >= 0) {
+            classes.push_back({Category::STRAIGHT, 1ULL * top, mask, product});
+            classes.push_back(
+                {Category::STRAIGHT_FLUSH, 1ULL * top, mask, product}
+            );
+         } else {
+            classes.push_back({Category::HIGH_CARD, tiebreak, mask, product});
+            classes.push_back({Category::FLUSH, tiebreak, mask, product});
+         }
+      } else {
+         Category category;
+         switch (groups.front().first) {
+            case 4:
+               category = Category::FOUR_OF_A_KIND;
+               break;
+            case 3:
+               category = groups.size() == 2 ? Category::FULL_HOUSE
+                                             : Category::THREE_OF_A_KIND;
+               break;
+            default:
+               category = groups.size() == 3 ? Category::TWO_PAIR
+                                             : Category::ONE_PAIR;
+               break;
+         }
+         classes.push_back({category, tiebreak, mask, product});
+      }
+   } while (nextMultiset(r));
+
+   sort(classes.begin(), classes.end(), [](auto &a, auto &b) {
+      return a.category != b.category ? a.category < b.category
+                                       : a.tiebreak < b.tiebreak;
+   });
+
+   for (unsigned mask = 0; mask < MASK_SIZE; ++mask) {
+      int k = 0;
+      for (unsigned rest = mask; rest; rest &= rest - 1) {
+         colex[mask] += choose(std::countr_zero(rest), ++k);
+      }
+   }
+
+   vector<pair<uint32_t, uint16_t>> paired;
+   paired.reserve(PAIRED_COUNT);
+   for (size_t i = 0; i < classes.size(); ++i) {
+      const HandClass &hc = classes[i];
+      uint16_t rank = static_cast<uint16_t>(i + 1);
+      auto group = [&hc](int n) { return (hc.tiebreak >> (4 * n)) & 0xF; };
+      switch (hc.category) {
+         case Category::ONE_PAIR: {
+            unsigned kickers = hc.mask ^ (1u << group(3));
+            pairs[group(3) * TRIPLE_SETS + colex[kickers]] = rank;
+            break;
+         }
+         case Category::TWO_PAIR: {
+            unsigned doubles = hc.mask ^ (1u << group(0));
+            twoPairs[colex[doubles] * RANK_COUNT + group(0)] = rank;
+            break;
+         }
+         case Category::THREE_OF_A_KIND: {
+            unsigned kickers = hc.mask ^ (1u << group(2));
+            trips[group(2) * PAIR_SETS + colex[kickers]] = rank;
+            break;
+         }
+         case Category::FULL_HOUSE:
+            fullHouses[group(1) * RANK_COUNT + group(0)] = rank;
+            break;
+         case Category::FOUR_OF_A_KIND:
+            quads[group(1) * RANK_COUNT + group(0)] = rank;
+            break;
+         default:
+            break;
+      }
+      switch (hc.category) {
+         case Category::FLUSH:
+         case Category::STRAIGHT_FLUSH:
+            flushes[hc.mask] = rank;
+            break;
+         case Category::HIGH_CARD:
+         case Category::STRAIGHT:
+            unique5[hc.mask] = rank;
+            break;
+         default:
+            paired.emplace_back(hc.product, rank);
+            break;
+      }
+   }
+   sort(paired.begin(), paired.end());
+   for (size_t i = 0; i < paired.size(); ++i) {
+      products[i] = paired[i].first;
+      values[i] = paired[i].second;
+   }
+
+   for (unsigned mask = 0; mask < MASK_SIZE; ++mask) {
+      for (unsigned straight : STRAIGHTS) {
+         if ((mask & straight) == straight) {
+            straights[mask] = unique5[straight];
+            suited[mask] = flushes[straight];
+            break;
+         }
+      }
+      if (std::popcount(mask) >= 5 && suited[mask] == 0) {
+         suited[mask] = flushes[keepHighest(mask, 5)];
+      }
+   }
+}
+
+const HandEvaluator::Tables &HandEvaluator::tables()
+{
+   static const Tables instance;
+   return instance;
+}
+
+uint32_t HandEvaluator::encode(int rank, int suit)
+{
+   return (1u << (16 + rank)) | (1u << (12 + suit)) | (rank << 8) |
+          PRIMES[rank];
+}
+
+uint32_t HandEvaluator::encode(CardId id)
+{
+   return encode(CardBits::getRank(id), CardBits::getSuit(id));
+}
+
+uint32_t HandEvaluator::encode(const Card &card)
+{
+   return encode(card.getId());
+}
+
+uint16_t HandEvaluator::evaluate(
+    uint32_t c1, uint32_t c2, uint32_t c3, uint32_t c4, uint32_t c5
+)
+{
+   const Tables &t = tables();
+   unsigned mask = (c1 | c2 | c3 | c4 | c5) >> 16;
+
+   if (c1 & c2 & c3 & c4 & c5 & 0xF000) { ///< All five share a suit bit
+      return t.flushes[mask];
+   }
+   if (t.unique5[mask]) { ///< Five distinct ranks
+      return t.unique5[mask];
+   }
+   uint32_t product =
+       (c1 & 0xFF) * (c2 & 0xFF) * (c3 & 0xFF) * (c4 & 0xFF) * (c5 & 0xFF);
+   auto it = lower_bound(t.products.begin(), t.products.end(), product);
+   return t.values[distance(t.products.begin(), it)];
+}
+
+uint16_t HandEvaluator::evaluate(CardMask mask)
+{
+   const Tables &t = tables();
+   unsigned ones = 0, twos = 0, fours = 0; ///< Bit-sliced rank counts
+
+   for (int suit = 0; suit < SUIT_COUNT; ++suit) {
+      unsigned field = CardBits::getSuitRanks(mask, suit);
+      if (t.suited[field]) {
+         return t.suited[field]; ///< Seven cards cannot also fill a house
+      }
+      unsigned carry = ones & field;
+      ones ^= field;
+      fours |= twos & carry;
+      twos ^= carry;
+   }
+
+   int surplus = CardBits::count(mask) - 5; ///< Cards beyond the best five
+   unsigned ranks = ones | twos | fours;
+   unsigned triples = ones & twos;
+   unsigned doubles = twos & ~ones;
+
+   if (fours) {
+      return t.quads[topRank(fours) * RANK_COUNT + topRank(ranks ^ fours)];
+   }
+   if (triples) {
+      int high = topRank(triples);
+      unsigned rest = (triples ^ (1u << high)) | doubles;
+      if (rest) {
+         return t.fullHouses[high * RANK_COUNT + topRank(rest)];
+      }
+   }
+   if (t.straights[ranks]) {
+      return t.straights[ranks];
+   }
+   if (triples) {
+      int high = topRank(triples);
+      unsigned kickers = dropLowest(ranks ^ (1u << high), surplus);
+      return t.trips[high * PAIR_SETS + t.colex[kickers]];
+   }
+   if (doubles & (doubles - 1)) { ///< Two or three pairs
+      unsigned high = doubles & (doubles - 1);
+      high = (high & (high - 1)) ? high : doubles;
+      return t.twoPairs[t.colex[high] * RANK_COUNT + topRank(ranks ^ high)];
+   }
+   if (doubles) {
+      int high = topRank(doubles);
+      unsigned kickers = dropLowest(ranks ^ (1u << high), surplus);
+      return t.pairs[high * TRIPLE_SETS + t.colex[kickers]];
+   }
+   return t.unique5[dropLowest(ranks, surplus)];
+}
+
+uint16_t HandEvaluator::evaluate(const CardId *ids, size_t count)
+{
+   CardMask mask = 0;
+   for (size_t i = 0; i < count; ++i) {
+      mask |= CardBits::toMask(ids[i]);
+   }
+   return evaluate(mask);
+}
+
+Category HandEvaluator::getCategory(uint16_t rank)
+{
+   if (rank == 0 || rank > CLASS_COUNT) {
+      return Category::INVALID_HAND;
+   }
+   auto it = upper_bound(CATEGORY_FLOOR.begin(), CATEGORY_FLOOR.end(), rank);
+   return static_cast<Category>(distance(CATEGORY_FLOOR.begin(), it) - 1);
+}
+
+string HandEvaluator::getDescription(uint16_t rank)
+{
+   return PokerHand::HAND_NAMES.at(getCategory(rank));
+}
@@ -0,0 +1,190 @@
+/**
+ * @file src/game/resources/HandEvaluator.h
+ * @brief Defines a table-driven evaluator for poker hands.
+ */
+#ifndef HANDEVALUATOR_H
+#define HANDEVALUATOR_H
+
+#include "CardBits.h"
+#include "PokerHand.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Card; ///< Forward declaration of Card class
+
+/**
+ * @class HandEvaluator
+ * @brief Ranks poker hands using precomputed lookup tables.
+ *
+ * Every five card hand falls into one of 7462 equivalence classes. The
+ * evaluator maps a hand to its class rank, from 1 (7-5-4-3-2 high card) to
+ * 7462 (royal flush), using a flush table and a unique-rank table indexed by
+ * the hand's rank bitmask, and a sorted prime-product table for paired hands.
+ *
+ * Six and seven card sets, as dealt in community card games, are ranked by
+ * their best five cards in a single pass over the set's CardMask: the suit
+ * fields decide flushes, bit-sliced rank counts decide the category, and
+ * small per-category tables give the rank. No five card subset is built.
+ *
+ * Arrays of card sets can be ranked together with evaluateBatch, which runs
+ * the same single pass algorithm on several hands at once with SIMD
+ * instructions where the processor supports them.
+ *
+ * The tables are built once on first use and evaluation never allocates.
+ */
+class HandEvaluator
+{
+ public:
+   static constexpr int CLASS_COUNT = 7462; ///< Number of hand classes.
+   static constexpr int RANK_COUNT = CardBits::RANK_COUNT; ///< Card ranks.
+   static constexpr int SUIT_COUNT = CardBits::SUIT_COUNT; ///< Card suits.
+
+   /**
+    * @brief Lowest class rank of each category, indexed by Category.
+    */
+   static constexpr std::array<std::uint16_t, 9> CATEGORY_FLOOR = {
+       1, 1278, 4138, 4996, 5854, 5864, 7141, 7297, 7453
+   };
+
+   /**
+    * @brief Encodes a card for evaluation.
+    *
+    * The code packs the rank bit (bits 16-28), the suit bit (bits 12-15), the
+    * rank index (bits 8-11) and the rank prime (bits 0-7).
+    *
+    * @param rank The rank index, from 0 (deuce) to 12 (ace).
+    * @param suit The suit index, from 0 to 3.
+    * @return std::uint32_t The encoded card.
+    */
+   static std::uint32_t encode(int rank, int suit);
+
+   /**
+    * @brief Encodes a card id for evaluation.
+    *
+    * @param id The card id.
+    * @return std::uint32_t The encoded card.
+    */
+   static std::uint32_t encode(CardId id);
+
+   /**
+    * @brief Encodes a Card object for evaluation.
+    *
+    * @param card The card to encode.
+    * @return std::uint32_t The encoded card.
+    */
+   static std::uint32_t encode(const Card &card);
+
+   /**
+    * @brief Returns the class rank of a five card hand.
+    *
+    * @param c1 .. c5 The encoded cards.
+    * @return std::uint16_t The class rank, from 1 (worst) to 7462 (best).
+    */
+   static std::uint16_t evaluate(
+       std::uint32_t c1, std::uint32_t c2, std::uint32_t c3, std::uint32_t c4,
+       std::uint32_t c5
+   );
+
+   /**
+    * @brief Returns the rank of the best five cards in a set of 5 to 7 cards.
+    *
+    * @param mask The set of cards.
+    * @return std::uint16_t The class rank, from 1 (worst) to 7462 (best).
+    */
+   static std::uint16_t evaluate(CardMask mask);
+
+   /**
+    * @brief Returns the rank of the best five cards in 5 to 7 card ids.
+    *
+    * @param ids The distinct card ids.
+    * @param count The number of card ids.
+    * @return std::uint16_t The class rank, from 1 (worst) to 7462 (best).
+    */
+   static std::uint16_t evaluate(const CardId *ids, std::size_t count);
+
+   /**
+    * @brief Returns the category of a class rank.
+    *
+    * @param rank The class rank.
+    * @return PokerHand::Category The category, or INVALID_HAND for rank 0.
+    */
+   static PokerHand::Category getCategory(std::uint16_t rank);
+
+   /**
+    * @brief Returns the category name of a class rank.
+    *
+    * @param rank The class rank.
+    * @return std::string The matching PokerHand::HAND_NAMES entry.
+    */
+   static std::string getDescription(std::uint16_t rank);
+
+   /**
+    * @brief Instruction sets available to the batch evaluator.
+    */
+   enum BatchKernel
+   {
+      SCALAR_KERNEL, ///< Portable loop over evaluate(CardMask)
+      SSE42_KERNEL,  ///< Four hands per step with SSE4.2
+      AVX2_KERNEL    ///< Eight hands per step with AVX2 gathers
+   };
+
+   /**
+    * @brief Returns the fastest batch kernel supported by this processor.
+    *
+    * @return BatchKernel
+    */
+   static BatchKernel getBatchKernel();
+
+   /**
+    * @brief Returns the name of a batch kernel.
+    *
+    * @param kernel The batch kernel.
+    * @return std::string
+    */
+   static std::string getBatchKernelName(BatchKernel kernel);
+
+   /**
+    * @brief Ranks an array of 5 to 7 card sets.
+    *
+    * Each output equals evaluate(in[i]). The kernel is chosen once, at the
+    * first call, from the instruction sets the processor reports.
+    *
+    * @param in The card sets.
+    * @param out Receives the class rank of each card set.
+    * @param n The number of card sets.
+    */
+   static void evaluateBatch(
+       const CardMask *in, std::uint16_t *out, std::size_t n
+   );
+
+   /**
+    * @brief Ranks an array of 5 to 7 card sets with a given kernel.
+    *
+    * A kernel the processor does not support falls back to the fastest one
+    * it does.
+    *
+    * @param in The card sets.
+    * @param out Receives the class rank of each card set.
+    * @param n The number of card sets.
+    * @param kernel The batch kernel.
+    */
+   static void evaluateBatch(
+       const CardMask *in, std::uint16_t *out, std::size_t n,
+       BatchKernel kernel
+   );
+
+   struct Tables; ///< Lookup tables, see HandEvaluatorTables.h.
+
+ private:
+
+   /**
+    * @brief Returns the lookup tables, building them on first use.
+    *
+    * @return const Tables&
+    */
+   static const Tables &tables();
+};
+
+#endif // HANDEVALUATOR_H
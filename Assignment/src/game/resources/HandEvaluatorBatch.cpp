@@ -0,0 +1,470 @@
+/**
+ * @file src/game/resources/HandEvaluatorBatch.cpp
+ * @brief Implementation of the HandEvaluator batch kernels.
+ *
+ * The SIMD kernels run the single pass algorithm of evaluate(CardMask) on
+ * every lane at once. Lanes cannot branch, so each kernel looks up a
+ * candidate rank for every category, zeroes the index of candidates the lane
+ * cannot form, and keeps the maximum. A zeroed index reads entry 0 of its
+ * table, which is always 0. A candidate whose kickers come up short is only
+ * ever formed beside a better category, so it never wins the maximum.
+ */
+#include "HandEvaluator.h"
+#include "HandEvaluatorTables.h"
+#include <algorithm>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HANDEVALUATOR_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+using Tables = HandEvaluator::Tables;
+
+/**
+ * @brief Ranks card sets one at a time.
+ */
+void evaluateScalar(const CardMask *in, uint16_t *out, size_t n)
+{
+   for (size_t i = 0; i < n; ++i) {
+      out[i] = HandEvaluator::evaluate(in[i]);
+   }
+}
+
+#ifdef HANDEVALUATOR_X86
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+
+constexpr int EXPONENT_BITS = 0x7F800000; ///< Exponent field of a float.
+constexpr int EXPONENT_BIAS = 127;        ///< Exponent of 1.0f.
+
+/**
+ * @brief Returns the index of the highest set bit in each lane.
+ *
+ * Lanes holding 0 give a negative index.
+ */
+TARGET_AVX2 inline __m256i topRank8(__m256i x)
+{
+   __m256i bits = _mm256_castps_si256(_mm256_cvtepi32_ps(x));
+   return _mm256_sub_epi32(
+       _mm256_srli_epi32(bits, 23), _mm256_set1_epi32(EXPONENT_BIAS)
+   );
+}
+
+/**
+ * @brief Returns the highest set bit of each lane, or 0.
+ */
+TARGET_AVX2 inline __m256i topBit8(__m256i x)
+{
+   __m256 power = _mm256_and_ps(
+       _mm256_cvtepi32_ps(x),
+       _mm256_castsi256_ps(_mm256_set1_epi32(EXPONENT_BITS))
+   );
+   return _mm256_cvttps_epi32(power);
+}
+
+/**
+ * @brief Clears all but the n highest set bits of each lane.
+ */
+TARGET_AVX2 inline __m256i keepHighest8(__m256i x, int n)
+{
+   __m256i kept = _mm256_setzero_si256();
+   for (; n > 0; --n) {
+      __m256i bit = topBit8(x);
+      kept = _mm256_or_si256(kept, bit);
+      x = _mm256_xor_si256(x, bit);
+   }
+   return kept;
+}
+
+/**
+ * @brief Returns all ones in lanes that are not 0.
+ */
+TARGET_AVX2 inline __m256i nonZero8(__m256i x)
+{
+   __m256i zero = _mm256_cmpeq_epi32(x, _mm256_setzero_si256());
+   return _mm256_xor_si256(zero, _mm256_set1_epi32(-1));
+}
+
+/**
+ * @brief Reads a 16-bit table entry for each lane.
+ *
+ * Each gather reads 32 bits, so the table needs one slot of padding.
+ */
+TARGET_AVX2 inline __m256i lookup8(const uint16_t *table, __m256i index)
+{
+   __m256i words = _mm256_i32gather_epi32(
+       reinterpret_cast<const int *>(table), index, sizeof(uint16_t)
+   );
+   return _mm256_and_si256(words, _mm256_set1_epi32(0xFFFF));
+}
+
+/**
+ * @brief Ranks card sets eight at a time with AVX2.
+ */
+TARGET_AVX2 void evaluateAvx2(
+    const Tables &t, const CardMask *in, uint16_t *out, size_t n
+)
+{
+   const __m256i field = _mm256_set1_epi32(CardBits::RANK_FIELD);
+   const __m256i one = _mm256_set1_epi32(1);
+   const __m256i rankCount = _mm256_set1_epi32(HandEvaluator::RANK_COUNT);
+   size_t i = 0;
+
+   for (; i + 8 <= n; i += 8) {
+      ///< Gather the low and the high 32 bits of the eight masks
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+      __m256i b =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i + 4));
+      a = _mm256_shuffle_epi32(a, _MM_SHUFFLE(3, 1, 2, 0));
+      b = _mm256_shuffle_epi32(b, _MM_SHUFFLE(3, 1, 2, 0));
+      a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(3, 1, 2, 0));
+      b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(3, 1, 2, 0));
+      __m256i low = _mm256_permute2x128_si256(a, b, 0x20);
+      __m256i high = _mm256_permute2x128_si256(a, b, 0x31);
+
+      ///< Suit fields start at bits 0, 13, 26 and 39 of each mask
+      const __m256i suits[4] = {
+          _mm256_and_si256(low, field),
+          _mm256_and_si256(_mm256_srli_epi32(low, 13), field),
+          _mm256_and_si256(
+              _mm256_or_si256(
+                  _mm256_srli_epi32(low, 26), _mm256_slli_epi32(high, 6)
+              ),
+              field
+          ),
+          _mm256_and_si256(_mm256_srli_epi32(high, 7), field)
+      };
+
+      __m256i ones = _mm256_setzero_si256();
+      __m256i twos = _mm256_setzero_si256();
+      __m256i fours = _mm256_setzero_si256();
+      __m256i best = _mm256_setzero_si256();
+      for (const __m256i &suit : suits) {
+         best = _mm256_max_epu32(best, lookup8(t.suited.data(), suit));
+         __m256i carry = _mm256_and_si256(ones, suit);
+         ones = _mm256_xor_si256(ones, suit);
+         fours = _mm256_or_si256(fours, _mm256_and_si256(twos, carry));
+         twos = _mm256_xor_si256(twos, carry);
+      }
+      __m256i ranks = _mm256_or_si256(_mm256_or_si256(ones, twos), fours);
+      __m256i triples = _mm256_and_si256(ones, twos);
+      __m256i doubles = _mm256_andnot_si256(ones, twos);
+      __m256i tripleBit = topBit8(triples);
+      __m256i tripleRank = topRank8(triples);
+      __m256i hasTriples = nonZero8(triples);
+
+      ///< Four of a kind
+      __m256i index = _mm256_add_epi32(
+          _mm256_mullo_epi32(topRank8(fours), rankCount),
+          topRank8(_mm256_xor_si256(ranks, fours))
+      );
+      index = _mm256_and_si256(index, nonZero8(fours));
+      best = _mm256_max_epu32(best, lookup8(t.quads.data(), index));
+
+      ///< Full house
+      __m256i rest =
+          _mm256_or_si256(_mm256_xor_si256(triples, tripleBit), doubles);
+      index = _mm256_add_epi32(
+          _mm256_mullo_epi32(tripleRank, rankCount), topRank8(rest)
+      );
+      index = _mm256_and_si256(
+          index, _mm256_and_si256(hasTriples, nonZero8(rest))
+      );
+      best = _mm256_max_epu32(best, lookup8(t.fullHouses.data(), index));
+
+      ///< Straight
+      best = _mm256_max_epu32(best, lookup8(t.straights.data(), ranks));
+
+      ///< Three of a kind
+      __m256i kickers = lookup8(
+          t.colex.data(),
+          keepHighest8(_mm256_xor_si256(ranks, tripleBit), 2)
+      );
+      index = _mm256_add_epi32(
+          _mm256_mullo_epi32(tripleRank, _mm256_set1_epi32(Tables::PAIR_SETS)),
+          kickers
+      );
+      index = _mm256_and_si256(index, hasTriples);
+      best = _mm256_max_epu32(best, lookup8(t.trips.data(), index));
+
+      ///< Two pair
+      __m256i pairBits = keepHighest8(doubles, 2);
+      index = _mm256_add_epi32(
+          _mm256_mullo_epi32(lookup8(t.colex.data(), pairBits), rankCount),
+          topRank8(_mm256_xor_si256(ranks, pairBits))
+      );
+      index = _mm256_and_si256(
+          index,
+          nonZero8(_mm256_and_si256(doubles, _mm256_sub_epi32(doubles, one)))
+      );
+      best = _mm256_max_epu32(best, lookup8(t.twoPairs.data(), index));
+
+      ///< One pair
+      kickers = lookup8(
+          t.colex.data(),
+          keepHighest8(_mm256_xor_si256(ranks, topBit8(doubles)), 3)
+      );
+      index = _mm256_add_epi32(
+          _mm256_mullo_epi32(
+              topRank8(doubles), _mm256_set1_epi32(Tables::TRIPLE_SETS)
+          ),
+          kickers
+      );
+      index = _mm256_and_si256(index, nonZero8(doubles));
+      best = _mm256_max_epu32(best, lookup8(t.pairs.data(), index));
+
+      ///< High card
+      best = _mm256_max_epu32(
+          best, lookup8(t.unique5.data(), keepHighest8(ranks, 5))
+      );
+
+      __m256i packed = _mm256_packus_epi32(best, best);
+      packed = _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0));
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i *>(out + i), _mm256_castsi256_si128(packed)
+      );
+   }
+   evaluateScalar(in + i, out + i, n - i);
+}
+
+/**
+ * @brief Returns the index of the highest set bit in each lane.
+ *
+ * Lanes holding 0 give a negative index.
+ */
+TARGET_SSE42 inline __m128i topRank4(__m128i x)
+{
+   __m128i bits = _mm_castps_si128(_mm_cvtepi32_ps(x));
+   return _mm_sub_epi32(
+       _mm_srli_epi32(bits, 23), _mm_set1_epi32(EXPONENT_BIAS)
+   );
+}
+
+/**
+ * @brief Returns the highest set bit of each lane, or 0.
+ */
+TARGET_SSE42 inline __m128i topBit4(__m128i x)
+{
+   __m128 power = _mm_and_ps(
+       _mm_cvtepi32_ps(x), _mm_castsi128_ps(_mm_set1_epi32(EXPONENT_BITS))
+   );
+   return _mm_cvttps_epi32(power);
+}
+
+/**
+ * @brief Clears all but the n highest set bits of each lane.
+ */
+TARGET_SSE42 inline __m128i keepHighest4(__m128i x, int n)
+{
+   __m128i kept = _mm_setzero_si128();
+   for (; n > 0; --n) {
+      __m128i bit = topBit4(x);
+      kept = _mm_or_si128(kept, bit);
+      x = _mm_xor_si128(x, bit);
+   }
+   return kept;
+}
+
+/**
+ * @brief Returns all ones in lanes that are not 0.
+ */
+TARGET_SSE42 inline __m128i nonZero4(__m128i x)
+{
+   __m128i zero = _mm_cmpeq_epi32(x, _mm_setzero_si128());
+   return _mm_xor_si128(zero, _mm_set1_epi32(-1));
+}
+
+/**
+ * @brief Reads a 16-bit table entry for each lane.
+ *
+ * SSE has no gather, so the lanes are read one by one.
+ */
+TARGET_SSE42 inline __m128i lookup4(const uint16_t *table, __m128i index)
+{
+   alignas(16) uint32_t lanes[4];
+   _mm_store_si128(reinterpret_cast<__m128i *>(lanes), index);
+   return _mm_setr_epi32(
+       table[lanes[0]], table[lanes[1]], table[lanes[2]], table[lanes[3]]
+   );
+}
+
+/**
+ * @brief Ranks card sets four at a time with SSE4.2.
+ */
+TARGET_SSE42 void evaluateSse42(
+    const Tables &t, const CardMask *in, uint16_t *out, size_t n
+)
+{
+   const __m128i field = _mm_set1_epi32(CardBits::RANK_FIELD);
+   const __m128i one = _mm_set1_epi32(1);
+   const __m128i rankCount = _mm_set1_epi32(HandEvaluator::RANK_COUNT);
+   size_t i = 0;
+
+   for (; i + 4 <= n; i += 4) {
+      ///< Gather the low and the high 32 bits of the four masks
+      __m128 a = _mm_castsi128_ps(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i))
+      );
+      __m128 b = _mm_castsi128_ps(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 2))
+      );
+      __m128i low = _mm_castps_si128(_mm_shuffle_ps(a, b, 0x88));
+      __m128i high = _mm_castps_si128(_mm_shuffle_ps(a, b, 0xDD));
+
+      ///< Suit fields start at bits 0, 13, 26 and 39 of each mask
+      const __m128i suits[4] = {
+          _mm_and_si128(low, field),
+          _mm_and_si128(_mm_srli_epi32(low, 13), field),
+          _mm_and_si128(
+              _mm_or_si128(_mm_srli_epi32(low, 26), _mm_slli_epi32(high, 6)),
+              field
+          ),
+          _mm_and_si128(_mm_srli_epi32(high, 7), field)
+      };
+
+      __m128i ones = _mm_setzero_si128();
+      __m128i twos = _mm_setzero_si128();
+      __m128i fours = _mm_setzero_si128();
+      __m128i best = _mm_setzero_si128();
+      for (const __m128i &suit : suits) {
+         best = _mm_max_epu32(best, lookup4(t.suited.data(), suit));
+         __m128i carry = _mm_and_si128(ones, suit);
+         ones = _mm_xor_si128(ones, suit);
+         fours = _mm_or_si128(fours, _mm_and_si128(twos, carry));
+         twos = _mm_xor_si128(twos, carry);
+      }
+      __m128i ranks = _mm_or_si128(_mm_or_si128(ones, twos), fours);
+      __m128i triples = _mm_and_si128(ones, twos);
+      __m128i doubles = _mm_andnot_si128(ones, twos);
+      __m128i tripleBit = topBit4(triples);
+      __m128i tripleRank = topRank4(triples);
+      __m128i hasTriples = nonZero4(triples);
+
+      ///< Four of a kind
+      __m128i index = _mm_add_epi32(
+          _mm_mullo_epi32(topRank4(fours), rankCount),
+          topRank4(_mm_xor_si128(ranks, fours))
+      );
+      index = _mm_and_si128(index, nonZero4(fours));
+      best = _mm_max_epu32(best, lookup4(t.quads.data(), index));
+
+      ///< Full house
+      __m128i rest = _mm_or_si128(_mm_xor_si128(triples, tripleBit), doubles);
+      index = _mm_add_epi32(
+          _mm_mullo_epi32(tripleRank, rankCount), topRank4(rest)
+      );
+      index =
+          _mm_and_si128(index, _mm_and_si128(hasTriples, nonZero4(rest)));
+      best = _mm_max_epu32(best, lookup4(t.fullHouses.data(), index));
+
+      ///< Straight
+      best = _mm_max_epu32(best, lookup4(t.straights.data(), ranks));
+
+      ///< Three of a kind
+      __m128i kickers = lookup4(
+          t.colex.data(), keepHighest4(_mm_xor_si128(ranks, tripleBit), 2)
+      );
+      index = _mm_add_epi32(
+          _mm_mullo_epi32(tripleRank, _mm_set1_epi32(Tables::PAIR_SETS)),
+          kickers
+      );
+      index = _mm_and_si128(index, hasTriples);
+      best = _mm_max_epu32(best, lookup4(t.trips.data(), index));
+
+      ///< Two pair
+      __m128i pairBits = keepHighest4(doubles, 2);
+      index = _mm_add_epi32(
+          _mm_mullo_epi32(lookup4(t.colex.data(), pairBits), rankCount),
+          topRank4(_mm_xor_si128(ranks, pairBits))
+      );
+      index = _mm_and_si128(
+          index, nonZero4(_mm_and_si128(doubles, _mm_sub_epi32(doubles, one)))
+      );
+      best = _mm_max_epu32(best, lookup4(t.twoPairs.data(), index));
+
+      ///< One pair
+      kickers = lookup4(
+          t.colex.data(),
+          keepHighest4(_mm_xor_si128(ranks, topBit4(doubles)), 3)
+      );
+      index = _mm_add_epi32(
+          _mm_mullo_epi32(
+              topRank4(doubles), _mm_set1_epi32(Tables::TRIPLE_SETS)
+          ),
+          kickers
+      );
+      index = _mm_and_si128(index, nonZero4(doubles));
+      best = _mm_max_epu32(best, lookup4(t.pairs.data(), index));
+
+      ///< High card
+      best = _mm_max_epu32(
+          best, lookup4(t.unique5.data(), keepHighest4(ranks, 5))
+      );
+
+      _mm_storel_epi64(
+          reinterpret_cast<__m128i *>(out + i), _mm_packus_epi32(best, best)
+      );
+   }
+   evaluateScalar(in + i, out + i, n - i);
+}
+#endif // HANDEVALUATOR_X86
+} // namespace
+
+HandEvaluator::BatchKernel HandEvaluator::getBatchKernel()
+{
+#ifdef HANDEVALUATOR_X86
+   static const BatchKernel kernel = [] {
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2")) {
+         return AVX2_KERNEL;
+      }
+      if (__builtin_cpu_supports("sse4.2")) {
+         return SSE42_KERNEL;
+      }
+      return SCALAR_KERNEL;
+   }();
+   return kernel;
+#else
+   return SCALAR_KERNEL;
+#endif
+}
+
+string HandEvaluator::getBatchKernelName(BatchKernel kernel)
+{
+   switch (kernel) {
+      case AVX2_KERNEL:
+         return "AVX2";
+      case SSE42_KERNEL:
+         return "SSE4.2";
+      default:
+         return "Scalar";
+   }
+}
+
+void HandEvaluator::evaluateBatch(const CardMask *in, uint16_t *out, size_t n)
+{
+   evaluateBatch(in, out, n, getBatchKernel());
+}
+
+void HandEvaluator::evaluateBatch(
+    const CardMask *in, uint16_t *out, size_t n, BatchKernel kernel
+)
+{
+   switch (min(kernel, getBatchKernel())) {
+#ifdef HANDEVALUATOR_X86
+      case AVX2_KERNEL:
+         evaluateAvx2(tables(), in, out, n);
+         break;
+      case SSE42_KERNEL:
+         evaluateSse42(tables(), in, out, n);
+         break;
+#endif
+      default:
+         evaluateScalar(in, out, n);
+         break;
+   }
+}
@@ -0,0 +1,54 @@
+/**
+ * @file src/game/resources/HandEvaluatorTables.h
+ * @brief Defines the lookup tables shared by the HandEvaluator sources.
+ *
+ * This header is internal to the evaluator and is not part of its interface.
+ */
+#ifndef HANDEVALUATORTABLES_H
+#define HANDEVALUATORTABLES_H
+
+#include "HandEvaluator.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * @struct HandEvaluator::Tables
+ * @brief Lookup tables shared by all evaluations.
+ *
+ * Entry 0 of every per-category table is unused and holds 0, so a lookup
+ * with a zeroed index never beats a real hand. The tables read by the batch
+ * kernels carry one slot of padding so that a 32-bit gather of their last
+ * entry stays in bounds.
+ */
+struct HandEvaluator::Tables
+{
+   static constexpr int MASK_SIZE = 1 << RANK_COUNT; ///< Rank bitmasks.
+   static constexpr int PAIRED_COUNT = 4888; ///< Patterns with a repeat.
+   static constexpr int PAIR_SETS = 78;      ///< Two rank subsets, C(13, 2).
+   static constexpr int TRIPLE_SETS = 286;   ///< Three rank subsets, C(13, 3).
+   static constexpr int PAD = 1;             ///< Slack for 32-bit gathers.
+
+   std::array<std::uint16_t, MASK_SIZE> flushes{}; ///< Flush ranks by bitmask.
+   std::array<std::uint16_t, MASK_SIZE + PAD> unique5{}; ///< Unpaired ranks.
+   std::array<std::uint32_t, PAIRED_COUNT> products{}; ///< Sorted products.
+   std::array<std::uint16_t, PAIRED_COUNT> values{}; ///< Matching ranks.
+
+   ///< Tables for the single pass evaluation of 5 to 7 card sets.
+   std::array<std::uint16_t, MASK_SIZE + PAD> colex{};     ///< Subset index.
+   std::array<std::uint16_t, MASK_SIZE + PAD> straights{}; ///< Best straight.
+   std::array<std::uint16_t, MASK_SIZE + PAD> suited{};    ///< Best flush.
+   std::array<std::uint16_t, RANK_COUNT * RANK_COUNT + PAD>
+       quads{}; ///< [quad][kicker]
+   std::array<std::uint16_t, RANK_COUNT * RANK_COUNT + PAD>
+       fullHouses{}; ///< [trips][pair]
+   std::array<std::uint16_t, RANK_COUNT * PAIR_SETS + PAD>
+       trips{}; ///< [trips][kickers]
+   std::array<std::uint16_t, PAIR_SETS * RANK_COUNT + PAD>
+       twoPairs{}; ///< [pairs][kicker]
+   std::array<std::uint16_t, RANK_COUNT * TRIPLE_SETS + PAD>
+       pairs{}; ///< [pair][kickers]
+
+   Tables();
+};
+
+#endif // HANDEVALUATORTABLES_H
@@ -0,0 +1,74 @@
+/**
+ * @file src/game/resources/HandNotation.cpp
+ * @brief Implementation of the HandNotation class.
+ */
+#include "HandNotation.h"
+
+using namespace std;
+
+namespace
+{
+/**
+ * @brief Checks whether a character separates cards.
+ */
+constexpr bool isSeparator(char c)
+{
+   return c == ' ' || c == ',' || (c >= '\t' && c <= '\r');
+}
+
+/**
+ * @brief Converts a lower case ASCII letter to upper case.
+ */
+constexpr char upper(char c)
+{
+   return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+} // namespace
+
+HandNotation::Result
+HandNotation::scan(string_view notation, CardId (&ids)[MAX_CARDS])
+{
+   CardMask seen = 0;
+   size_t count = 0;
+   size_t i = 0;
+
+   while (i < notation.size()) {
+      if (isSeparator(notation[i])) {
+         ++i;
+         continue;
+      }
+      if (i + 1 >= notation.size()) {
+         return {INVALID_CARD, count, i};
+      }
+      CardId id =
+          CardBits::toId(upper(notation[i]), upper(notation[i + 1]));
+      if (id == CardBits::INVALID_ID) {
+         return {INVALID_CARD, count, i};
+      }
+      if (CardBits::contains(seen, id)) {
+         return {DUPLICATE_CARD, count, i};
+      }
+      if (count == MAX_CARDS) {
+         return {TOO_MANY_CARDS, count, i};
+      }
+      seen |= CardBits::toMask(id);
+      ids[count++] = id;
+      i += 2;
+   }
+   return {OK, count, notation.size()};
+}
+
+string HandNotation::getMessage(const Result &result)
+{
+   string at = " at position " + to_string(result.position) + ".";
+   switch (result.status) {
+      case OK:
+         return "Scanned " + to_string(result.count) + " cards.";
+      case INVALID_CARD:
+         return "Invalid card" + at;
+      case DUPLICATE_CARD:
+         return "Duplicate card" + at;
+      default:
+         return "Too many cards" + at;
+   }
+}
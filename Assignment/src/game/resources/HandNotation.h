@@ -0,0 +1,68 @@
+/**
+ * @file src/game/resources/HandNotation.h
+ * @brief Defines a scanner for hand notation strings.
+ */
+#ifndef HANDNOTATION_H
+#define HANDNOTATION_H
+
+#include "CardBits.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class HandNotation
+ * @brief Scans hand notation into card ids without allocating.
+ *
+ * A notation is a list of two character cards, rank then suit, such as
+ * "AS KS QS JS TS", "As,Ks,Qs,Js,Ts" or "AsKsQsJsTs". Ranks and suits are
+ * case insensitive, and cards may be separated by whitespace, commas or
+ * nothing at all. Repeated cards are reported instead of being dropped.
+ */
+class HandNotation
+{
+ public:
+   static constexpr std::size_t MAX_CARDS = 7; ///< Cards in a notation.
+
+   /**
+    * @brief Enumerates the outcomes of a scan.
+    */
+   enum Status
+   {
+      OK = 0,
+      INVALID_CARD = 1,   ///< A character is not a rank or a suit
+      DUPLICATE_CARD = 2, ///< A card appears more than once
+      TOO_MANY_CARDS = 3  ///< More than MAX_CARDS cards
+   };
+
+   /**
+    * @brief Describes the outcome of a scan.
+    */
+   struct Result
+   {
+      Status status;
+      std::size_t count;    ///< Cards written to the output
+      std::size_t position; ///< Offset of the offending card, if any
+   };
+
+   /**
+    * @brief Scans a notation into card ids.
+    *
+    * Scanning stops at the first error; the ids before it are kept.
+    *
+    * @param notation The hand notation.
+    * @param ids Receives the card ids in notation order.
+    * @return Result
+    */
+   static Result scan(std::string_view notation, CardId (&ids)[MAX_CARDS]);
+
+   /**
+    * @brief Returns a readable description of a scan result.
+    *
+    * @param result The scan result.
+    * @return std::string
+    */
+   static std::string getMessage(const Result &result);
+};
+
+#endif // HANDNOTATION_H
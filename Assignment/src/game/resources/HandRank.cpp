@@ -0,0 +1,18 @@
+/**
+ * @file src/game/resources/HandRank.cpp
+ * @brief Implementation of the HandRank class.
+ */
+#include "HandRank.h"
+#include "HandEvaluator.h"
+
+using namespace std;
+
+int HandRank::getCategory() const
+{
+   return HandEvaluator::getCategory(value);
+}
+
+string HandRank::getDescription() const
+{
+   return HandEvaluator::getDescription(value);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file src/game/resources/HandRank.h
+ * @brief Defines a compact value type for a hand's class rank.
+ */
+#ifndef HANDRANK_H
+#define HANDRANK_H
+
+#include <compare>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class HandRank
+ * @brief The HandEvaluator class rank of a hand, in two bytes.
+ *
+ * Ranks run from 1 (7-5-4-3-2 high card) to 7462 (royal flush), and a
+ * higher rank beats a lower one, so ranks order and compare as the hands
+ * do. Rank 0 stands for an invalid hand and orders below every valid one.
+ * Large arrays of ranks or outcomes holding them sort in a quarter of the
+ * memory that scores of type long long take.
+ */
+class HandRank
+{
+ public:
+   static constexpr std::uint16_t INVALID = 0; ///< Rank of an invalid hand
+   static constexpr std::uint16_t WORST = 1;   ///< 7-5-4-3-2 high card
+   static constexpr std::uint16_t BEST = 7462; ///< Royal flush
+
+   /**
+    * @brief Constructs the rank of an invalid hand.
+    */
+   constexpr HandRank() = default;
+
+   /**
+    * @brief Constructs a rank from its value.
+    *
+    * @param value The class rank, from 1 to 7462; any other value makes
+    * the rank of an invalid hand.
+    */
+   constexpr explicit HandRank(std::uint16_t value)
+       : value(value > BEST ? INVALID : value)
+   {}
+
+   /**
+    * @brief Returns the class rank.
+    *
+    * @return std::uint16_t The rank, from 1 to 7462, or 0 if invalid.
+    */
+   constexpr std::uint16_t getValue() const
+   {
+      return value;
+   }
+
+   /**
+    * @brief Checks whether the rank belongs to a valid hand.
+    *
+    * @return true if the rank is from 1 to 7462.
+    */
+   constexpr bool isValid() const
+   {
+      return value != INVALID;
+   }
+
+   /**
+    * @brief Returns the category of the rank.
+    *
+    * @return int The PokerHand::Category, or INVALID_HAND if invalid.
+    */
+   int getCategory() const;
+
+   /**
+    * @brief Returns the category name of the rank.
+    *
+    * @return std::string The matching PokerHand::HAND_NAMES entry.
+    */
+   std::string getDescription() const;
+
+   /**
+    * @brief Orders ranks as the hands they belong to.
+    */
+   constexpr auto operator<=>(const HandRank &other) const = default;
+
+ private:
+   std::uint16_t value = INVALID; ///< The class rank
+};
+
+static_assert(sizeof(HandRank) == 2, "A HandRank must stay two bytes");
+
+#endif // HANDRANK_H
@@ -0,0 +1,109 @@
+/**
+ * @file src/game/resources/HandStrength.cpp
+ * @brief Implementation of the HandStrength class.
+ */
+#include "HandStrength.h"
+#include "HandEvaluator.h"
+#include <array>
+
+using namespace std;
+
+namespace
+{
+constexpr int CLASSES = HandEvaluator::CLASS_COUNT;
+constexpr int OPPONENTS = HandStrength::MAX_OPPONENTS;
+
+/**
+ * @brief Hands in each class of a category, indexed by Category.
+ */
+constexpr array<uint32_t, 9> CATEGORY_SIZE = {
+    1020, 384, 144, 64, 1020, 4, 24, 4, 4
+};
+
+/**
+ * @brief Checks whether a rank names a class.
+ */
+constexpr bool isClass(uint16_t rank)
+{
+   return rank >= 1 && rank <= CLASSES;
+}
+} // namespace
+
+/**
+ * @struct HandStrength::Tables
+ * @brief Strength of every class, indexed by class rank.
+ */
+struct HandStrength::Tables
+{
+   array<uint32_t, CLASSES + 1> size{};  ///< Hands in the class
+   array<uint32_t, CLASSES + 1> below{}; ///< Hands in lower classes
+   array<array<double, OPPONENTS + 1>, CLASSES + 1> win{}; ///< By opponents
+
+   /**
+    * @brief Builds the tables from the category of each class rank.
+    */
+   Tables()
+   {
+      const auto &floor = HandEvaluator::CATEGORY_FLOOR;
+      uint32_t total = 0;
+      for (int rank = 1, category = 0; rank <= CLASSES; ++rank) {
+         while (category + 1 < static_cast<int>(floor.size()) &&
+                rank >= floor[category + 1]) {
+            ++category;
+         }
+         size[rank] = CATEGORY_SIZE[category];
+         below[rank] = total;
+         total += size[rank];
+
+         ///< The chance that j of k opponents tie and the rest are beaten,
+         ///< shared among the j + 1 tied hands
+         double beaten = double(below[rank]) / HANDS;
+         double tied = double(size[rank]) / HANDS;
+         array<double, OPPONENTS + 1> beatenPow{1}, tiedPow{1};
+         for (int i = 1; i <= OPPONENTS; ++i) {
+            beatenPow[i] = beatenPow[i - 1] * beaten;
+            tiedPow[i] = tiedPow[i - 1] * tied;
+         }
+         for (int k = 1; k <= OPPONENTS; ++k) {
+            double share = 0, choose = 1;
+            for (int j = 0; j <= k; ++j) {
+               share += choose * tiedPow[j] * beatenPow[k - j] / (j + 1);
+               choose = choose * (k - j) / (j + 1);
+            }
+            win[rank][k] = share;
+         }
+      }
+   }
+};
+
+const HandStrength::Tables &HandStrength::tables()
+{
+   static const Tables instance;
+   return instance;
+}
+
+uint32_t HandStrength::getClassSize(uint16_t rank)
+{
+   return isClass(rank) ? tables().size[rank] : 0;
+}
+
+uint32_t HandStrength::getHandsBelow(uint16_t rank)
+{
+   return isClass(rank) ? tables().below[rank] : 0;
+}
+
+double HandStrength::getPercentile(uint16_t rank)
+{
+   if (!isClass(rank)) {
+      return 0;
+   }
+   return (tables().below[rank] + tables().size[rank] / 2.0) / HANDS;
+}
+
+double HandStrength::getWinProbability(uint16_t rank, int opponents)
+{
+   if (!isClass(rank) || opponents < 1 || opponents > MAX_OPPONENTS) {
+      return 0;
+   }
+   return tables().win[rank][opponents];
+}
@@ -0,0 +1,79 @@
+/**
+ * @file src/game/resources/HandStrength.h
+ * @brief Defines the standing of each hand class among all hands.
+ */
+#ifndef HANDSTRENGTH_H
+#define HANDSTRENGTH_H
+
+#include <cstdint>
+
+/**
+ * @class HandStrength
+ * @brief Maps a class rank to its percentile and its odds against others.
+ *
+ * Every HandEvaluator class of a category holds the same number of the
+ * 2,598,960 five card hands: 1020 for each high card or straight class,
+ * 384 for one pair, 144 for two pair, 64 for three of a kind, 24 for a full
+ * house and 4 for each flush, four of a kind or straight flush class. The
+ * strength of every class therefore follows from its rank alone. The table
+ * of them takes about 0.5 MB, is built once on first use from the category
+ * floors, without evaluating a hand, and lookups are O(1).
+ *
+ * Win probabilities treat each opponent as holding a random five card hand
+ * of its own, independent of the hand and of the other opponents, so card
+ * removal is ignored. A tie counts as the hand's share of the split pot.
+ */
+class HandStrength
+{
+ public:
+   static constexpr int MAX_OPPONENTS = 6;         ///< Most opponents tabled
+   static constexpr std::uint32_t HANDS = 2598960; ///< Five card hands
+
+   /**
+    * @brief Returns how many five card hands share a class.
+    *
+    * @param rank The class rank, from 1 to 7462.
+    * @return std::uint32_t The number of hands, or 0 for an invalid rank.
+    */
+   static std::uint32_t getClassSize(std::uint16_t rank);
+
+   /**
+    * @brief Returns how many five card hands rank below a class.
+    *
+    * @param rank The class rank, from 1 to 7462.
+    * @return std::uint32_t The number of hands, or 0 for an invalid rank.
+    */
+   static std::uint32_t getHandsBelow(std::uint16_t rank);
+
+   /**
+    * @brief Returns the percentile of a class among all five card hands.
+    * @details Hands of the class itself count half, so the percentiles of
+    * all hands average one half.
+    *
+    * @param rank The class rank, from 1 to 7462.
+    * @return double The percentile, from 0 to 1, or 0 for an invalid rank.
+    */
+   static double getPercentile(std::uint16_t rank);
+
+   /**
+    * @brief Returns the chance of a class winning against random hands.
+    *
+    * @param rank The class rank, from 1 to 7462.
+    * @param opponents The number of opponents, from 1 to MAX_OPPONENTS.
+    * @return double The expected share of the pot, from 0 to 1, or 0 for
+    * an invalid rank or number of opponents.
+    */
+   static double getWinProbability(std::uint16_t rank, int opponents);
+
+   struct Tables; ///< Class strengths, see HandStrength.cpp.
+
+ private:
+   /**
+    * @brief Returns the class strengths, building them on first use.
+    *
+    * @return const Tables&
+    */
+   static const Tables &tables();
+};
+
+#endif // HANDSTRENGTH_H
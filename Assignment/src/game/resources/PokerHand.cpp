@@ -6,13 +6,11 @@
 #include "../../../utils/Logger.h"
 #include "Card.h"
 #include "Hand.h"
+#include "HandEvaluator.h"
+#include "HandNotation.h"
 #include <algorithm>
 #include <bitset>
-#include <cmath>
 #include <iostream>
-#include <map>
-#include <regex>
-#include <unordered_set>
 
 using namespace std;
 using CardPtr = shared_ptr<Card>;
@@ -30,15 +28,21 @@ const vector<string> PokerHand::HAND_NAMES = {
     "Straight flush",
     "Invalid"};
 
-PokerHand::PokerHand() : Hand(vector<CardPtr>()), detail{INVALID_HAND, 0} {}
+PokerHand::PokerHand()
+    : Hand(vector<CardPtr>()), detail{INVALID_HAND, {}}, stale(false), mask(0),
+      rankCounts{}, suitCounts{}, validCards(0), invalidCards(0)
+{}
 
 PokerHand::PokerHand(string notation)
-    : Hand(parse(notation)), detail{INVALID_HAND, 0}
+    : Hand(parse(notation)), detail{INVALID_HAND, {}}, stale(true), mask(0),
+      rankCounts{}, suitCounts{}, validCards(0), invalidCards(0)
 {
    process();
 }
 
-PokerHand::PokerHand(vector<CardPtr> &cards) : Hand(cards)
+PokerHand::PokerHand(vector<CardPtr> &cards)
+    : Hand(cards), detail{INVALID_HAND, {}}, stale(true), mask(0),
+      rankCounts{}, suitCounts{}, validCards(0), invalidCards(0)
 {
    process();
 }
@@ -52,6 +56,7 @@ bool PokerHand::validate(const vector<CardPtr> &cards)
       );
       return false;
    }
+   CardMask seen = 0;
    for (auto &card : cards) {
       if (!card->isValid()) {
          Logger::debug(
@@ -60,92 +65,113 @@ bool PokerHand::validate(const vector<CardPtr> &cards)
          );
          return false;
       }
+      CardMask bit = CardBits::toMask(card->getId());
+      if (seen & bit) {
+         Logger::debug(
+             string("Poker Hand validation: ") +
+             "Duplicate card found: " + card->getName() + "."
+         );
+         return false;
+      }
+      seen |= bit;
    }
    return true;
 }
 
 void PokerHand::process()
 {
-   valid = validate(cards);
+   mask = 0;
+   rankCounts.fill(0);
+   suitCounts.fill(0);
+   validCards = invalidCards = 0;
+   for (auto &card : cards) {
+      tally(card, 1);
+   }
+   valid = !cards.empty() && validate(cards); ///< An emptied hand logs nothing
    std::sort(cards.begin(), cards.end(), Hand::sort);
-   compute();
+   stale = true;
+}
+
+void PokerHand::added(const CardPtr &card)
+{
+   tally(card, 1);
+   auto last = prev(cards.end()); ///< Move the new card into sorted place
+   auto place = upper_bound(cards.begin(), last, card, Hand::sort);
+   rotate(place, last, cards.end());
+   revalidate();
+   stale = true;
+}
+
+void PokerHand::removed(const CardPtr &card)
+{
+   tally(card, -1);
+   revalidate();
+   stale = true;
+}
+
+void PokerHand::tally(const CardPtr &card, int delta)
+{
+   if (!card->isValid()) {
+      invalidCards += delta;
+      return;
+   }
+   CardId id = card->getId();
+   rankCounts[CardBits::getRank(id)] += delta;
+   suitCounts[CardBits::getSuit(id)] += delta;
+   validCards += delta;
+   if (delta > 0) {
+      mask |= CardBits::toMask(id);
+   } else if (none_of(cards.begin(), cards.end(), [id](auto &other) {
+                 return other->getId() == id;
+              })) {
+      mask &= ~CardBits::toMask(id); ///< No repeat of the card remains
+   }
+}
+
+void PokerHand::revalidate()
+{
+   valid = invalidCards == 0 && validCards == VALID_COUNT &&
+           CardBits::count(mask) == VALID_COUNT;
 }
 
 void PokerHand::compute()
 {
-   int categoryShift = HBWIDTH; ///< Shift for category bits
-   long long categoryBase;      ///< Base value for category bits
-   long long ordinality = getOrdinality();
-
-   if (valid) {
-      if (isFlush() && isStraight()) {
-         detail.category = STRAIGHT_FLUSH;
-      } else if (isFourOfAKind()) {
-         detail.category = FOUR_OF_A_KIND;
-      } else if (isFullHouse()) {
-         detail.category = FULL_HOUSE;
-      } else if (isFlush()) {
-         detail.category = FLUSH;
-      } else if (isStraight()) {
-         detail.category = STRAIGHT;
-      } else if (isThreeOfAKind()) {
-         detail.category = THREE_OF_A_KIND;
-      } else if (isTwoPair()) {
-         detail.category = TWO_PAIR;
-      } else if (isOnePair()) {
-         detail.category = ONE_PAIR;
-      } else {
-         detail.category = HIGH_CARD;
-      }
-      categoryBase = (1LL * detail.category);
-      if (detail.category >= STRAIGHT) {
-         categoryBase += 1;
-         if (detail.category >= STRAIGHT_FLUSH) {
-            categoryBase += 1;
-         }
-      }
+   stale = true;
+   getDetail();
+}
 
-      ///< if the hand is a low straight, adjust the category base
-      if (detail.category == STRAIGHT || detail.category == STRAIGHT_FLUSH) {
-         if (cards[0]->getValue() == 2 && cards[4]->getValue() == 14) {
-            categoryBase--; ///< Reduce the category base by 1
-         }
+const PokerHand::Detail &PokerHand::getDetail() const
+{
+   if (stale) {
+      if (valid) {
+         detail.rank = HandRank(HandEvaluator::evaluate(mask));
+         detail.category = HandEvaluator::getCategory(detail.rank.getValue());
+      } else {
+         detail.category = INVALID_HAND;
+         detail.rank = HandRank();
       }
-      detail.score = ordinality;
-      detail.score |= (categoryBase << categoryShift);
-      Logger::debug(string("Hand ordinality: ") + to_string(ordinality));
-      Logger::debug(string("Hand Category: ") + to_string(detail.category));
-      Logger::debug(string("Hand score: ") + to_string(detail.score));
-   } else {
-      Logger::trace("Hand:  Invalid hand detected.");
-      detail.category = INVALID_HAND;
-      detail.score = 0;
+      stale = false;
    }
+   return detail;
 }
 
 vector<CardPtr> PokerHand::parse(const string notation)
 {
-   unordered_set<string> tokens;
-   string delimiter = "\\s+";
-   regex patt(delimiter);
-   vector<CardPtr> cards_;
-   sregex_token_iterator end;
-
-   Logger::trace(
-       string("Poker Hand: ") + "Parsing notation: " + notation + "."
-   );
-   sregex_token_iterator token(notation.begin(), notation.end(), patt, -1);
-   for (; token != end; ++token) {
-      tokens.insert(*token);
-      Logger::trace(
-          string("Poker Hand: ") + "Token matched: " + token->str() + "."
+   CardId ids[HandNotation::MAX_CARDS];
+   HandNotation::Result result = HandNotation::scan(notation, ids);
+   if (result.status != HandNotation::OK) {
+      Logger::debug(
+          string("Poker Hand: ") + HandNotation::getMessage(result) +
+          " Notation: " + notation + "."
       );
-   }
-   for (string token : tokens) {
-      cards_.push_back(make_shared<Card>(token));
-      Logger::trace(string("Poker Hand: ") + "Token inserted: " + token + ".");
+      return {};
    }
 
+   vector<CardPtr> cards_;
+   cards_.reserve(result.count);
+   for (size_t i = 0; i < result.count; ++i) {
+      cards_.push_back(Card::get(ids[i]));
+   }
    return cards_;
 }
 
@@ -169,133 +195,60 @@ bool PokerHand::isValid() const
    return valid;
 }
 
+CardMask PokerHand::getMask() const
+{
+   return mask;
+}
+
 long long PokerHand::getScore() const
 {
-   return detail.score;
+   return getDetail().rank.getValue();
 }
 
 string PokerHand::getScore(bool grouped) const
 {
-   string binStr = bitset<64>(detail.score).to_string();
+   string binStr = bitset<16>(getDetail().rank.getValue()).to_string();
    if (grouped) {
-      binStr.insert(51, " ");
-      binStr.insert(38, " ");
-      binStr.insert(25, " ");
       binStr.insert(12, " ");
+      binStr.insert(8, " ");
+      binStr.insert(4, " ");
    }
    return binStr;
 }
 
-int PokerHand::getCategory() const
-{
-   return detail.category;
-}
-
-bool PokerHand::isFlush() const
-{
-   // Compare suit of all cards to the first one
-   return std::all_of(
-       cards.begin(),
-       cards.end(),
-       [s = cards.front()->getSuit()](const CardPtr &card) {
-          return card->getSuit() == s;
-       }
-   );
-}
-
-bool PokerHand::isStraight() const
-{
-   // Check if the cards form a numerical sequence
-   for (size_t i = 1; i < cards.size(); ++i) {
-      int a = cards[i]->getValue(), b = cards[i - 1]->getValue();
-      if ((a != (b + 1)) && !(i == 4 && a == 14 && b == 5)) { // Low Ace
-         return false;
-      }
-   }
-   return true;
-}
-
-bool PokerHand::isThreeOfAKind() const
+HandRank PokerHand::getRank() const
 {
-   // Check for exactly three cards of the same rank
-   return getCardinality() == 3 && getCardinality(true) == 3;
+   return getDetail().rank;
 }
 
-bool PokerHand::isFourOfAKind() const
-{
-   // Check for exactly four cards of the same rank
-   return getCardinality() == 2 && getCardinality(true) == 4;
-}
-
-bool PokerHand::isFullHouse() const
+int PokerHand::getCategory() const
 {
-   return getCardinality() == 2 && getCardinality(true) == 3;
+   return getDetail().category;
 }
 
-bool PokerHand::isTwoPair() const
+string PokerHand::getDescription() const
 {
-   // Exactly two pairs of cards
-   return (getCardinality() == 3 && getCardinality(true) == 2);
+   return HAND_NAMES.at(getDetail().category);
 }
 
-bool PokerHand::isOnePair() const
+int PokerHand::getRankCount(int rank) const
 {
-   // Exactly one pair of cards
-   return getCardinality() == 4 && getCardinality(true) == 2;
+   return rankCounts.at(rank);
 }
 
-int PokerHand::getCardinality(const bool inverse) const
+int PokerHand::getSuitCount(int suit) const
 {
-   map<int, int> ranks;
-   int cardinality = 0;
-   for (const auto &card : cards) {
-      ranks[card->getValue()]++;
-   }
-   for (const auto &it : ranks) {
-      if (inverse) {
-         cardinality = max(cardinality, it.second);
-      } else {
-         cardinality = it.second > 0 ? cardinality + 1 : cardinality;
-      }
-   }
-   return cardinality;
+   return suitCounts.at(suit);
 }
 
-long long PokerHand::getOrdinality(int startIdx) const
+uint32_t PokerHand::getSuitClass() const
 {
-   map<char, long long> suits = {{'C', 0}, {'D', 1}, {'H', 2}, {'S', 3}};
-   map<int, long long> rcnts;
-   long long ordinality = 0;
-   long long rank_range = 1LL * 13;
-   long long count_range = 3LL * 13;
-   long long suit, count_base, rank_shift, count_shift;
-   int j = VALID_COUNT;
-   int rank;
-
-   for (const auto &card : cards) { ///< Count cards by rank
-      rcnts[card->getValue()]++;
-   }
-
-   for (int i = 0; i < cards.size(); ++i) {
-      if (VALID_COUNT - startIdx >= j) {       ///< Exclude first startIdx cards
-         CardPtr card = cards.at(i);           ///< Get the card
-         rank = card->getValue();              ///< Get the rank value
-         rank_shift = 1LL * (rank - 2);        ///< Get rank shift
-         count_shift = (rcnts[rank] - 2) * 13; ///< Get count shift
-         count_base = 1LL * (rank - 2);        ///< Get count multiply
-         ordinality |= (1LL << rank_shift);    ///< Set rank bit
-         if (rcnts[rank] > 1) {                ///< Set count bit
-            ordinality |= (1LL << count_base << count_shift << rank_range);
-         }
-      }
-      j--;
-   }
-   return ordinality;
+   return valid ? SuitIsomorphism::index(mask) : SuitIsomorphism::INVALID_CLASS;
 }
 
-string PokerHand::getDescription() const
+SuitIsomorphism::Canonical PokerHand::canonicalize(CardMask dead) const
 {
-   return HAND_NAMES.at(detail.category);
+   return SuitIsomorphism::canonicalize(mask, dead);
 }
 
 vector<string> PokerHand::getCardNames(bool verbose) const
@@ -331,7 +284,7 @@ vector<int> PokerHand::indexByCategory(const Category category) const
       case STRAIGHT:
       case FLUSH:
       case FULL_HOUSE:
-         if (detail.category == category) {
+         if (getDetail().category == category) {
             for (int i = 0; i < cards.size(); ++i) {
                indices.push_back(i);
             }
@@ -347,14 +300,11 @@ vector<int> PokerHand::indexByCategory(const Category category) const
 vector<int> PokerHand::indexByCardinality(const int cardinality) const
 {
    vector<int> indices;
-   map<int, int> ranks;
-   for (const auto &card : cards) {
-      ranks[card->getValue()]++;
-   }
-   for (const auto &it : ranks) {
-      if (it.second == cardinality) {
+   for (int rank = 0; rank < CardBits::RANK_COUNT; ++rank) {
+      if (rankCounts[rank] == cardinality) {
          for (size_t i = 0; i < cards.size(); ++i) {
-            if (cards[i]->getValue() == it.first) {
+            if (cards[i]->isValid() &&
+                CardBits::getRank(cards[i]->getId()) == rank) {
                indices.push_back(i);
             }
          }
@@ -5,8 +5,13 @@
 #ifndef POKERHAND_H
 #define POKERHAND_H
 
+#include "CardBits.h"
 #include "Hand.h"
+#include "HandRank.h"
+#include "SuitIsomorphism.h"
+#include <array>
 #include <compare>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,6 +24,14 @@ class Card; ///< Forward declaration of Card class
  *
  * The PokerHand class is a derived class of the Hand class and provides
  * functionality to simulate a poker hand.
+ *
+ * Adding or removing a card updates the hand's rank counts, suit counts and
+ * card mask in place and keeps the cards sorted. The category and score are
+ * computed on first request after a change, so a hand dealt one card at a
+ * time is evaluated once rather than after every card.
+ *
+ * Hands that differ only by suits share a SuitIsomorphism class, so an
+ * analysis of the hand can be cached under its class or its canonical form.
  */
 class PokerHand : public Hand
 {
@@ -40,8 +53,6 @@ class PokerHand : public Hand
       INVALID_HAND = 9
    };
 
-   static const int HBWIDTH = 52; ///< The base mask width for the hand
-
    /**
     * @brief Defines hand names.
     */
@@ -49,11 +60,14 @@ class PokerHand : public Hand
 
    /**
     * @brief Stores information about the hand.
+    *
+    * The rank is the hand's equivalence class rank from HandEvaluator, from
+    * 1 (7-5-4-3-2 high card) to 7462 (royal flush), or 0 for invalid hands.
     */
    struct Detail
    {
       Category category;
-      long long score;
+      HandRank rank;
    };
 
    /**
@@ -85,6 +99,11 @@ class PokerHand : public Hand
     */
    std::vector<std::string> getCardNames(bool verbose = true) const override;
 
+   /**
+    * @see CardCollection::getMask
+    */
+   CardMask getMask() const override;
+
    /**
     * @see Hand::getScore
     */
@@ -95,6 +114,14 @@ class PokerHand : public Hand
     */
    std::string getScore(bool grouped) const override;
 
+   /**
+    * @brief Returns the hand's class rank.
+    * @details The same value as getScore(), in two bytes.
+    *
+    * @return HandRank The rank, invalid if the hand is not valid.
+    */
+   HandRank getRank() const;
+
    /**
     * @see Hand::getCategory
     */
@@ -110,6 +137,38 @@ class PokerHand : public Hand
     */
    std::string getDescription() const override;
 
+   /**
+    * @brief Returns how many cards of a rank the hand holds.
+    *
+    * @param rank The rank index, from 0 (deuce) to 12 (ace).
+    * @return int
+    */
+   int getRankCount(int rank) const;
+
+   /**
+    * @brief Returns how many cards of a suit the hand holds.
+    *
+    * @param suit The suit index, from 0 to 3.
+    * @return int
+    */
+   int getSuitCount(int suit) const;
+
+   /**
+    * @brief Returns the hand's class under relabeling of suits.
+    *
+    * @return std::uint32_t The SuitIsomorphism class index, or
+    * SuitIsomorphism::INVALID_CLASS if the hand is not valid.
+    */
+   std::uint32_t getSuitClass() const;
+
+   /**
+    * @brief Relabels the hand's suits, and those of dead cards, canonically.
+    *
+    * @param dead Cards out of play, e.g. the hand's discards.
+    * @return SuitIsomorphism::Canonical
+    */
+   SuitIsomorphism::Canonical canonicalize(CardMask dead = 0) const;
+
    /**
     * @brief Get the indices of cards that match a given Category.
     *
@@ -155,87 +214,49 @@ class PokerHand : public Hand
    void process() override;
 
    /**
-    * @see Hand::compute
-    */
-   void compute() override;
-
- private:
-   static const int VALID_COUNT{5}; ///< The valid count of cards in a hand
-   Detail detail;                   ///< Hand detail information
-
-   /**
-    * @brief Checks if the hand is a flush.
-    *
-    * @return true if the hand is a flush, false otherwise.
+    * @see Hand::added
     */
-   bool isFlush() const;
+   void added(const std::shared_ptr<Card> &card) override;
 
    /**
-    * @brief Checks if the hand is a straight.
-    *
-    * @return true if the hand is a straight, false otherwise.
+    * @see Hand::removed
     */
-   bool isStraight() const;
+   void removed(const std::shared_ptr<Card> &card) override;
 
    /**
-    * @brief Checks if the hand is three of a kind.
-    *
-    * @return true if the hand is three of a kind, false otherwise.
-    */
-   bool isThreeOfAKind() const;
-
-   /**
-    * @brief Checks if the hand is four of a kind.
-    *
-    * @return true if the hand is four of a kind, false otherwise.
-    */
-   bool isFourOfAKind() const;
-
-   /**
-    * @brief Checks if the hand is a full house.
-    *
-    * @return true if the hand is a full house, false otherwise.
-    */
-   bool isFullHouse() const;
-
-   /**
-    * @brief Checks if the hand is two pair.
-    *
-    * @return true if the hand is two pair, false otherwise.
+    * @see Hand::compute
     */
-   bool isTwoPair() const;
+   void compute() override;
 
-   /**
-    * @brief Checks if the hand is one pair.
-    *
-    * @return true if the hand is one pair, false otherwise.
-    */
-   bool isOnePair() const;
+ private:
+   static const int VALID_COUNT{5}; ///< The valid count of cards in a hand
+   mutable Detail detail;           ///< Hand detail, computed on demand
+   mutable bool stale;              ///< Detail predates the last change
+   CardMask mask;                   ///< Set of valid cards in the hand
+   std::array<std::uint8_t, CardBits::RANK_COUNT> rankCounts; ///< By rank
+   std::array<std::uint8_t, CardBits::SUIT_COUNT> suitCounts; ///< By suit
+   int validCards;   ///< Number of valid cards, repeats included
+   int invalidCards; ///< Number of invalid cards
 
    /**
-    * @brief Checks if the hand has exactly n pairs of cards.
+    * @brief Adds a card to, or removes it from, the running counts.
     *
-    * @param n Number of pairs to check for.
-    * @return true if hand has exactly n pairs of cards, otherwise false
+    * @param card The card.
+    * @param delta 1 for an added card, -1 for a removed card.
     */
-   bool countPairs() const;
+   void tally(const std::shared_ptr<Card> &card, int delta);
 
    /**
-    * @brief Returns the number of distinct or identical cards in a hand.
-    * @param inverse Flag to return the number of identical cards.
-    *
-    * @return The number of distinct cards in the hand.
+    * @brief Sets the valid flag from the running counts.
     */
-   int getCardinality(const bool inverse = false) const;
+   void revalidate();
 
    /**
-    * @brief Returns the rank value of the nth highest card.
+    * @brief Returns the hand detail, computing it if it is stale.
     *
-    * @param startIdx The starting index to consider when finding the nth
-    * highest card.
-    * @return The rank value of the nth highest card.
+    * @return const Detail&
     */
-   long long getOrdinality(int startIdx = 0) const;
+   const Detail &getDetail() const;
 };
 
 #endif // POKERHAND_H
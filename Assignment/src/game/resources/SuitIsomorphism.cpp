@@ -0,0 +1,148 @@
+/**
+ * @file src/game/resources/SuitIsomorphism.cpp
+ * @brief Implementation of the SuitIsomorphism class.
+ */
+#include "SuitIsomorphism.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct SuitIsomorphism::Tables
+ * @brief The canonical hand of every class, in increasing order.
+ */
+struct SuitIsomorphism::Tables
+{
+   std::vector<CardMask> hands; ///< By class index
+
+   /**
+    * @brief Keeps every five card hand that is its own canonical form.
+    */
+   Tables()
+   {
+      hands.reserve(CLASS_COUNT);
+      const CardMask end = CardMask{1} << CardBits::DECK_SIZE;
+      for (CardMask hand = (CardMask{1} << HAND_SIZE) - 1; hand < end;
+           hand = CardBits::nextCombination(hand)) {
+         if (isCanonical(hand)) {
+            hands.push_back(hand);
+         }
+      }
+   }
+};
+
+namespace
+{
+/**
+ * @brief Returns the sort key of each suit, its hand field above its dead
+ * field.
+ */
+array<uint32_t, SuitIsomorphism::SUIT_COUNT> suitKeys(
+    CardMask hand, CardMask dead
+)
+{
+   array<uint32_t, SuitIsomorphism::SUIT_COUNT> keys;
+   for (int suit = 0; suit < SuitIsomorphism::SUIT_COUNT; ++suit) {
+      keys[suit] = CardBits::getSuitRanks(hand, suit) << CardBits::RANK_COUNT |
+                   CardBits::getSuitRanks(dead, suit);
+   }
+   return keys;
+}
+} // namespace
+
+const SuitIsomorphism::Tables &SuitIsomorphism::tables()
+{
+   static const Tables instance;
+   return instance;
+}
+
+SuitIsomorphism::Canonical
+SuitIsomorphism::canonicalize(CardMask hand, CardMask dead)
+{
+   ///< Sort the suits by key, largest first, carrying each suit's index in
+   ///< the low bits; a fixed network of five swaps sorts four keys
+   auto keys = suitKeys(hand, dead);
+   for (int suit = 0; suit < SUIT_COUNT; ++suit) {
+      keys[suit] = keys[suit] << 2 | (SUIT_COUNT - 1 - suit);
+   }
+   auto order = [&keys](int a, int b) {
+      if (keys[a] < keys[b]) {
+         swap(keys[a], keys[b]);
+      }
+   };
+   order(0, 1);
+   order(2, 3);
+   order(0, 2);
+   order(1, 3);
+   order(1, 2);
+
+   Canonical canonical;
+   for (int label = 0; label < SUIT_COUNT; ++label) {
+      int suit = SUIT_COUNT - 1 - static_cast<int>(keys[label] & 3);
+      canonical.suits[suit] = static_cast<uint8_t>(label);
+   }
+   canonical.hand = relabel(hand, canonical.suits);
+   canonical.dead = relabel(dead, canonical.suits);
+   return canonical;
+}
+
+CardMask SuitIsomorphism::relabel(
+    CardMask mask, const array<uint8_t, SUIT_COUNT> &suits
+)
+{
+   CardMask relabeled = 0;
+   for (int suit = 0; suit < SUIT_COUNT; ++suit) {
+      relabeled |= CardMask{CardBits::getSuitRanks(mask, suit)}
+                   << (suits[suit] * CardBits::RANK_COUNT);
+   }
+   return relabeled;
+}
+
+CardMask SuitIsomorphism::restore(CardMask mask, const Canonical &canonical)
+{
+   array<uint8_t, SUIT_COUNT> inverse;
+   for (int suit = 0; suit < SUIT_COUNT; ++suit) {
+      inverse[canonical.suits[suit]] = static_cast<uint8_t>(suit);
+   }
+   return relabel(mask, inverse);
+}
+
+uint32_t SuitIsomorphism::index(CardMask hand)
+{
+   if (CardBits::count(hand) != HAND_SIZE || (hand & ~CardBits::FULL_DECK)) {
+      return INVALID_CLASS;
+   }
+   const auto &hands = tables().hands;
+   CardMask canonical = canonicalize(hand).hand;
+   return static_cast<uint32_t>(
+       lower_bound(hands.begin(), hands.end(), canonical) - hands.begin()
+   );
+}
+
+CardMask SuitIsomorphism::unindex(uint32_t index)
+{
+   return index < CLASS_COUNT ? tables().hands[index] : 0;
+}
+
+int SuitIsomorphism::size(uint32_t index)
+{
+   if (index >= CLASS_COUNT) {
+      return 0;
+   }
+   ///< Canonical fields are sorted, so equal fields are adjacent
+   auto keys = suitKeys(unindex(index), 0);
+   int size = 24, run = 1;
+   for (int suit = 1; suit < SUIT_COUNT; ++suit) {
+      run = keys[suit] == keys[suit - 1] ? run + 1 : 1;
+      size /= run;
+   }
+   return size;
+}
+
+bool SuitIsomorphism::isCanonical(CardMask hand, CardMask dead)
+{
+   auto keys = suitKeys(hand, dead);
+   return keys[0] >= keys[1] && keys[1] >= keys[2] && keys[2] >= keys[3];
+}
@@ -0,0 +1,129 @@
+/**
+ * @file src/game/resources/SuitIsomorphism.h
+ * @brief Maps card sets that differ only by suits to one representative.
+ */
+#ifndef SUITISOMORPHISM_H
+#define SUITISOMORPHISM_H
+
+#include "CardBits.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * @class SuitIsomorphism
+ * @brief Canonicalizes hands under permutation of the four suits.
+ *
+ * Suits have no order in poker, so any analysis of a hand gives the same
+ * answer for all hands found by relabeling its suits. A hand's canonical
+ * form relabels the suits by their 13-bit rank fields, largest first, so
+ * that clubs hold the highest field and spades the lowest. Dead cards, such
+ * as discards, can be canonicalized with the hand: suits are then ordered
+ * by their hand field and, between equal hand fields, by their dead field.
+ *
+ * The 2,598,960 five card hands fall into 134,459 classes. Each class has a
+ * dense index, in increasing order of its canonical CardMask, so class
+ * results can be kept in flat arrays. The canonical forms of all classes
+ * are found once, on first use, and indexing a hand is a binary search.
+ *
+ * Canonicalizing takes a few dozen instructions and never allocates.
+ */
+class SuitIsomorphism
+{
+ public:
+   static constexpr int SUIT_COUNT = CardBits::SUIT_COUNT; ///< Card suits.
+   static constexpr int HAND_SIZE = 5;                     ///< Indexed size.
+   static constexpr std::uint32_t CLASS_COUNT = 134459;    ///< Hand classes.
+   static constexpr std::uint32_t INVALID_CLASS = 0xFFFFFFFF; ///< No class.
+
+   /**
+    * @brief A card set in canonical form, and how to return from it.
+    */
+   struct Canonical
+   {
+      CardMask hand = 0; ///< The hand, relabeled
+      CardMask dead = 0; ///< The dead cards, relabeled the same way
+      std::array<std::uint8_t, SUIT_COUNT> suits{0, 1, 2, 3}; ///< By suit,
+                                                               ///< its label
+   };
+
+   /**
+    * @brief Relabels the suits of a hand and its dead cards canonically.
+    *
+    * @param hand The hand's cards.
+    * @param dead Cards out of play, e.g. discards. Not part of the hand.
+    * @return Canonical The relabeled sets, and the relabeling used.
+    */
+   static Canonical canonicalize(CardMask hand, CardMask dead = 0);
+
+   /**
+    * @brief Relabels the suits of a card set.
+    *
+    * @param mask The card set.
+    * @param suits The new suit index of each suit index.
+    * @return CardMask The relabeled set.
+    */
+   static CardMask relabel(
+       CardMask mask, const std::array<std::uint8_t, SUIT_COUNT> &suits
+   );
+
+   /**
+    * @brief Returns a canonical card set to the suits it was taken from.
+    * @details The set can be any set of cards in canonical labels, e.g. a
+    * draw found for the canonical hand.
+    *
+    * @param mask The card set, in canonical labels.
+    * @param canonical The canonicalization it came from.
+    * @return CardMask The set in the original labels.
+    */
+   static CardMask restore(CardMask mask, const Canonical &canonical);
+
+   /**
+    * @brief Returns the class index of a five card hand.
+    *
+    * @param hand The hand, in any labels.
+    * @return std::uint32_t The class index, from 0 to CLASS_COUNT - 1, or
+    * INVALID_CLASS if the hand does not hold five cards.
+    */
+   static std::uint32_t index(CardMask hand);
+
+   /**
+    * @brief Returns the canonical hand of a class.
+    *
+    * @param index The class index.
+    * @return CardMask The canonical five card hand, or 0 if the index is
+    * out of range.
+    */
+   static CardMask unindex(std::uint32_t index);
+
+   /**
+    * @brief Returns how many hands a class holds.
+    * @details The 24 relabelings of a hand give distinct hands except where
+    * they swap suits with equal rank fields.
+    *
+    * @param index The class index.
+    * @return int The number of hands, from 4 to 24, or 0 if the index is
+    * out of range.
+    */
+   static int size(std::uint32_t index);
+
+   /**
+    * @brief Checks whether a card set is in canonical form.
+    *
+    * @param hand The hand's cards.
+    * @param dead The dead cards.
+    * @return true if canonicalizing the sets would not change them.
+    */
+   static bool isCanonical(CardMask hand, CardMask dead = 0);
+
+   struct Tables; ///< Canonical hands, see SuitIsomorphism.cpp.
+
+ private:
+   /**
+    * @brief Returns the canonical hands, finding them on first use.
+    *
+    * @return const Tables&
+    */
+   static const Tables &tables();
+};
+
+#endif // SUITISOMORPHISM_H
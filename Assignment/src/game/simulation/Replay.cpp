@@ -0,0 +1,85 @@
+/**
+ * @file src/game/simulation/Replay.cpp
+ * @brief Implementation of the Replay class.
+ */
+#include "Replay.h"
+#include "../../../utils/Logger.h"
+#include "../PokerEngine.h"
+#include "../history/HistoryReader.h"
+#include "../player/ReplayPokerPlayer.h"
+#include <chrono>
+#include <vector>
+
+using namespace std;
+using ReplayPlayerPtr = shared_ptr<ReplayPokerPlayer>;
+
+Replay::Results
+Replay::run(const string &path, shared_ptr<HistoryWriter> recorder)
+{
+   Results results;
+   HistoryReader reader(path);
+   if (!reader.isOpen()) {
+      return results;
+   }
+
+   auto start = chrono::steady_clock::now();
+   auto engine = make_shared<PokerEngine>();
+   engine->setHeadless(true);
+   engine->setRecorder(recorder);
+   vector<ReplayPlayerPtr> players;
+   vector<double> shares;
+   HandHistory::Hand hand;
+
+   while (reader.next(hand)) {
+      if (hand.seats.size() != players.size()) {
+         engine->clearPlayers();
+         players.clear();
+         for (size_t seat = 0; seat < hand.seats.size(); ++seat) {
+            auto player = make_shared<ReplayPokerPlayer>(engine, seat + 1);
+            players.push_back(player);
+            engine->addPlayer(player);
+         }
+      }
+      engine->reset();
+      engine->setAnte(hand.ante);
+      engine->setDealer(hand.dealer);
+      engine->setDealOrder(&hand.cards);
+      for (size_t seat = 0; seat < players.size(); ++seat) {
+         players[seat]->load(hand.seats[seat]);
+      }
+      engine->startGame();
+
+      double pot = engine->getPot();
+      auto winners = engine->determineWinners();
+      shares.assign(players.size(), 0.0);
+      for (auto &[index, outcome] : winners) {
+         shares[index] += pot / winners.size();
+      }
+      if (!matches(hand, shares)) {
+         Logger::debug("Replayed hand " + to_string(hand.number) + " differs.");
+         if (results.firstMismatch < 0) {
+            results.firstMismatch = results.hands;
+         }
+         results.mismatches++;
+      }
+      results.hands++;
+   }
+   engine->setDealOrder(nullptr);
+   engine->clearPlayers();
+   chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+   results.complete = reader.isComplete();
+   results.seconds = elapsed.count();
+   return results;
+}
+
+bool Replay::matches(
+    const HandHistory::Hand &hand, const vector<double> &shares
+)
+{
+   for (size_t seat = 0; seat < hand.seats.size(); ++seat) {
+      if (hand.seats[seat].won != shares[seat]) {
+         return false;
+      }
+   }
+   return true;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file src/game/simulation/Replay.h
+ * @brief Plays recorded hand histories again.
+ */
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "../history/HandHistory.h"
+#include "../history/HistoryWriter.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class Replay
+ * @brief Replays every hand of a history file on a headless engine.
+ *
+ * Each hand is dealt from its recorded cards and played by
+ * ReplayPokerPlayers repeating the recorded bets and discards, so it plays
+ * out exactly as it did, with no prompts, input or shuffles. The winners
+ * and their shares are checked against the recording, which makes a large
+ * history a regression test for the engine and evaluator, and a fixed
+ * workload for benchmarking them.
+ */
+class Replay
+{
+ public:
+   /**
+    * @brief Totals over every hand replayed.
+    */
+   struct Results
+   {
+      long hands = 0;          ///< Hands replayed
+      long mismatches = 0;     ///< Hands whose winners differ
+      long firstMismatch = -1; ///< Position of the first, counting from 0
+      bool complete = false;   ///< The history ended after a whole hand
+      double seconds = 0;      ///< Wall clock time
+   };
+
+   /**
+    * @brief Replays every hand of a history file.
+    *
+    * @param path The history file.
+    * @param recorder Records the replayed hands too, or nullptr.
+    * @return Results The totals.
+    */
+   static Results
+   run(const std::string &path,
+       std::shared_ptr<HistoryWriter> recorder = nullptr);
+
+ private:
+   /**
+    * @brief Returns whether a replayed hand paid the recorded winners.
+    *
+    * @param hand The recorded hand.
+    * @param shares Each seat's replayed share of the pot.
+    * @return true if every seat won what it won before.
+    */
+   static bool matches(
+       const HandHistory::Hand &hand, const std::vector<double> &shares
+   );
+};
+
+#endif // REPLAY_H
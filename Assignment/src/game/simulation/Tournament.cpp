@@ -0,0 +1,142 @@
+/**
+ * @file src/game/simulation/Tournament.cpp
+ * @brief Implementation of the Tournament class.
+ */
+#include "Tournament.h"
+#include "../../../utils/Logger.h"
+#include "../../../utils/WorkStealingPool.h"
+#include "../PokerEngine.h"
+#include "../player/AIPokerPlayer.h"
+#include <chrono>
+#include <memory>
+#include <random>
+#include <spdlog/sinks/null_sink.h>
+
+using namespace std;
+using AIPlayerPtr = shared_ptr<AIPokerPlayer>;
+
+namespace
+{
+/**
+ * @brief One worker's results, padded so workers never share a cache line.
+ */
+struct alignas(64) Accumulator
+{
+   Tournament::Results results;
+};
+
+/**
+ * @brief Returns a logger that drops everything, one per thread.
+ */
+shared_ptr<spdlog::logger> quietLogger()
+{
+   thread_local auto logger = [] {
+      auto quiet = make_shared<spdlog::logger>(
+          "tournament", make_shared<spdlog::sinks::null_sink_st>()
+      );
+      quiet->set_level(spdlog::level::off);
+      return quiet;
+   }();
+   return logger;
+}
+} // namespace
+
+void Tournament::Results::merge(const Results &other)
+{
+   tables += other.tables;
+   finished += other.finished;
+   games += other.games;
+   splits += other.splits;
+   pots += other.pots;
+   for (size_t i = 0; i < categories.size(); ++i) {
+      categories[i] += other.categories[i];
+   }
+   seatWins.resize(max(seatWins.size(), other.seatWins.size()));
+   for (size_t i = 0; i < other.seatWins.size(); ++i) {
+      seatWins[i] += other.seatWins[i];
+   }
+}
+
+Tournament::Results Tournament::run(const Options &options)
+{
+   vector<Accumulator> accumulators(max<size_t>(options.threads, 1));
+   for (auto &accumulator : accumulators) {
+      accumulator.results.seatWins.resize(options.seats);
+   }
+
+   auto start = chrono::steady_clock::now();
+   size_t steals = 0;
+   {
+      WorkStealingPool pool(accumulators.size());
+      for (int table = 0; table < options.tables; ++table) {
+         pool.submit([&options, &accumulators, table]() {
+            Logger::setThreadLogger(quietLogger());
+            int worker = WorkStealingPool::getWorkerIndex();
+            playTable(options, table, accumulators[worker].results);
+         });
+      }
+      pool.wait();
+      steals = pool.getSteals();
+   }
+   chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+   Results total;
+   total.seatWins.resize(options.seats);
+   for (auto &accumulator : accumulators) {
+      total.merge(accumulator.results);
+   }
+   total.seconds = elapsed.count();
+   total.steals = steals;
+   return total;
+}
+
+void Tournament::playTable(const Options &options, int table, Results &results)
+{
+   auto deck = make_shared<Deck>();
+   seed_seq deckSeq{options.seed, uint32_t(table)};
+   uint32_t deckSeed[2];
+   deckSeq.generate(begin(deckSeed), end(deckSeed));
+   deck->seed(uint64_t(deckSeed[0]) << 32 | deckSeed[1]);
+   auto engine = make_shared<PokerEngine>(deck);
+   engine->setAnte(options.ante);
+   engine->setHeadless(true);
+   vector<AIPlayerPtr> players;
+   for (int seat = 0; seat < options.seats; ++seat) {
+      double balance = options.balance;
+      auto player = make_shared<AIPokerPlayer>(engine, seat + 1, balance);
+      seed_seq seq{options.seed, uint32_t(table), uint32_t(seat)};
+      uint32_t seed;
+      seq.generate(&seed, &seed + 1);
+      player->seed(seed);
+      players.push_back(player);
+      engine->addPlayer(player);
+   }
+
+   for (int game = 0; game < options.games; ++game) {
+      int solvent = 0;
+      for (auto &player : players) {
+         solvent += player->show().playerBalance >= options.ante;
+      }
+      if (solvent < 2) {
+         results.finished++;
+         break;
+      }
+
+      engine->reset();
+      engine->startGame();
+      double pot = engine->getPot();
+      auto winners = engine->payWinners();
+      for (auto &[index, outcome] : winners) {
+         results.seatWins[index]++;
+         int category = outcome.playerHand->getCategory();
+         if (category < PokerHand::INVALID_HAND) {
+            results.categories[category]++;
+         }
+      }
+      results.splits += winners.size() > 1;
+      results.pots += pot;
+      results.games++;
+   }
+   engine->clearPlayers();
+   results.tables++;
+}
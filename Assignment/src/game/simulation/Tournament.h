@@ -0,0 +1,84 @@
+/**
+ * @file src/game/simulation/Tournament.h
+ * @brief Plays many independent poker tables in parallel.
+ */
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "../resources/PokerHand.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @class Tournament
+ * @brief Runs headless tables of AI players on a work-stealing pool.
+ *
+ * Each table is one task that builds its own engine, deck and players, so
+ * tables share nothing while they play. A table deals hands until one
+ * player is left who can pay the ante, or until its hand limit, paying
+ * each pot to the winners. Results gather in one accumulator per worker
+ * and are merged once every table has finished.
+ */
+class Tournament
+{
+ public:
+   /**
+    * @brief How many tables to play and how to seat them.
+    */
+   struct Options
+   {
+      int tables = 1000;       ///< Tables to play
+      int games = 100;         ///< Hand limit per table
+      int seats = 4;           ///< AI players per table
+      double balance = 1000.0; ///< Starting balance of each player
+      double ante = 10.0;      ///< Ante per hand
+      std::uint32_t seed = 0;  ///< Seeds the decks and players
+      size_t threads = std::max(1u, std::thread::hardware_concurrency());
+   };
+
+   /**
+    * @brief Totals over every table played.
+    */
+   struct Results
+   {
+      long tables = 0;   ///< Tables played
+      long finished = 0; ///< Tables down to one player
+      long games = 0;    ///< Hands played
+      long splits = 0;   ///< Hands with two winners
+      double pots = 0;   ///< Sum of every pot
+      std::array<long, PokerHand::INVALID_HAND> categories{}; ///< Of winners
+      std::vector<long> seatWins; ///< Hands won by each seat
+      double seconds = 0;         ///< Wall clock time
+      size_t steals = 0;          ///< Tables run by another worker
+
+      /**
+       * @brief Adds the totals of another accumulator.
+       *
+       * @param other The other totals.
+       */
+      void merge(const Results &other);
+   };
+
+   /**
+    * @brief Plays every table.
+    *
+    * @param options The tables to play.
+    * @return Results The merged totals.
+    */
+   static Results run(const Options &options);
+
+ private:
+   /**
+    * @brief Plays one table to the end.
+    *
+    * @param options The tournament options.
+    * @param table The table number.
+    * @param results The calling worker's accumulator.
+    */
+   static void playTable(const Options &options, int table, Results &results);
+};
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,434 @@
+/**
+ * @file test/CardUnitTest.cpp
+ * @brief Unit tests for the Card, CardCollection and Deck classes.
+ */
+#include "./CardUnitTest.h"
+#include "../../catch_amalgamated.hpp"
+#include "../src/game/resources/Card.h"
+#include "../src/game/resources/CardBits.h"
+#include "../src/game/resources/CardCollection.h"
+#include "../src/game/resources/Deck.h"
+#include "../src/game/resources/PokerHand.h"
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+using Test = CardUnitTest;
+using CardPtr = std::shared_ptr<Card>;
+using namespace std;
+
+/**
+ * @brief Build a card mask.
+ *
+ * @param notation
+ * @return CardMask
+ */
+CardMask Test::toMask(const string &notation)
+{
+   istringstream iss(notation);
+   string token;
+   CardMask mask = 0;
+   while (iss >> token) {
+      mask |= CardBits::toMask(Card(token).getId());
+   }
+   return mask;
+}
+
+/**
+ * @brief Test section for verifying compact card ids.
+ */
+TEST_CASE("Test Card Ids")
+{
+   /**
+    * @brief Every card survives a round trip through its id.
+    */
+   SECTION("Round Trip")
+   {
+      for (int id = 0; id < CardBits::DECK_SIZE; ++id) {
+         Card card(static_cast<CardId>(id));
+         REQUIRE(card.isValid() == true);
+         REQUIRE(card.getId() == id);
+         REQUIRE(Card(card.getName()).getId() == id);
+         REQUIRE(card.getValue() == CardBits::getRank(id) + 2);
+      }
+   }
+
+   /**
+    * @brief Ids follow Card::suits then Card::ranks order.
+    */
+   SECTION("Ordering")
+   {
+      REQUIRE(Card("2C").getId() == 0);
+      REQUIRE(Card("AC").getId() == 12);
+      REQUIRE(Card("2D").getId() == 13);
+      REQUIRE(Card("AS").getId() == 51);
+      REQUIRE(Card("1S").getId() == CardBits::INVALID_ID);
+      REQUIRE(Card("3F").getId() == CardBits::INVALID_ID);
+   }
+
+   /**
+    * @brief Suit fields of a mask hold rank bitmasks.
+    */
+   SECTION("Rank Fields")
+   {
+      CardMask mask = Test::toMask("AS KS 2D 2S");
+      REQUIRE(CardBits::count(mask) == 4);
+      REQUIRE(CardBits::getSuitRanks(mask, 3) == 0x1801);
+      REQUIRE(CardBits::getSuitRanks(mask, 1) == 0x0001);
+      REQUIRE(CardBits::getRanks(mask) == 0x1801);
+   }
+
+   /**
+    * @brief Character tables agree with Card::ranks and Card::suits.
+    */
+   SECTION("Character Tables")
+   {
+      static_assert(CardBits::toId('A', 'S') == 51);
+      static_assert(CardBits::toId('a', 'S') == CardBits::INVALID_ID);
+      for (size_t i = 0; i < Card::ranks.size(); ++i) {
+         REQUIRE(CardBits::toRank(Card::ranks[i]) == int(i));
+         REQUIRE(CardBits::RANK_CHARS[i] == Card::ranks[i]);
+      }
+      for (size_t i = 0; i < Card::suits.size(); ++i) {
+         REQUIRE(CardBits::toSuit(Card::suits[i]) == int(i));
+         REQUIRE(CardBits::SUIT_CHARS[i] == Card::suits[i]);
+      }
+      for (int c = 0; c < 256; ++c) {
+         bool rank = CardBits::toRank(char(c)) >= 0;
+         bool suit = CardBits::toSuit(char(c)) >= 0;
+         REQUIRE(rank == (find(Card::ranks.begin(), Card::ranks.end(), c) !=
+                          Card::ranks.end()));
+         REQUIRE(suit == (find(Card::suits.begin(), Card::suits.end(), c) !=
+                          Card::suits.end()));
+      }
+   }
+
+   /**
+    * @brief Cards compare by rank alone.
+    */
+   SECTION("Rank Comparison")
+   {
+      auto ace = make_shared<Card>("AD");
+      REQUIRE((Card("AS") == ace) == true);
+      REQUIRE((Card("KS") < ace) == true);
+      REQUIRE(is_eq(Card("2C") <=> make_shared<Card>("2H")));
+      REQUIRE(Card("TH").getValue() == 10);
+      REQUIRE(Card("XH").getValue() == -1);
+   }
+}
+
+/**
+ * @brief Test section for verifying colex indices of card sets.
+ */
+TEST_CASE("Test Card Combinations")
+{
+   /**
+    * @brief The lowest and highest hands take the ends of the range.
+    */
+   SECTION("Bounds")
+   {
+      static_assert(CardBits::CHOOSE[5][52] == CardBits::HAND_COMBINATIONS);
+      static_assert(CardBits::rankCombination(0x1F) == 0);
+      static_assert(
+          CardBits::unrankCombination(CardBits::HAND_COMBINATIONS - 1) ==
+          CardBits::FULL_DECK - ((CardMask{1} << 47) - 1)
+      );
+      REQUIRE(CardBits::HAND_COMBINATIONS < (1u << 22));
+      REQUIRE(CardBits::unrankCombination(CardBits::HAND_COMBINATIONS) == 0);
+      REQUIRE(CardBits::unrankCombination(0, 6) == 0);
+      REQUIRE(CardBits::rankCombination(0) == 0);
+      REQUIRE(CardBits::unrankCombination(0, 0) == 0);
+
+      ///< Sets the index cannot number are refused
+      REQUIRE(
+          CardBits::rankCombination(0x3F) == CardBits::INVALID_COMBINATION
+      );
+      REQUIRE(
+          CardBits::rankCombination(CardMask{1} << 60) ==
+          CardBits::INVALID_COMBINATION
+      );
+
+      ///< The step after the highest hand leaves the deck
+      static_assert(CardBits::nextCombination(0x1F) == 0x2F);
+      REQUIRE(
+          CardBits::nextCombination(
+              CardBits::unrankCombination(CardBits::HAND_COMBINATIONS - 1)
+          ) > CardBits::FULL_DECK
+      );
+   }
+
+   /**
+    * @brief Every hand, in mask order, takes the next index and returns
+    * from it.
+    */
+   SECTION("Every Hand")
+   {
+      const CardMask end = CardMask{1} << CardBits::DECK_SIZE;
+      uint32_t index = 0;
+      bool matched = true;
+      for (CardMask hand = 0x1F; hand < end; ++index) {
+         matched = matched && CardBits::rankCombination(hand) == index &&
+                   CardBits::unrankCombination(index) == hand;
+         hand = CardBits::nextCombination(hand);
+      }
+      REQUIRE(matched);
+      REQUIRE(index == CardBits::HAND_COMBINATIONS);
+   }
+
+   /**
+    * @brief Smaller sets are numbered among sets of their own size.
+    */
+   SECTION("Smaller Sets")
+   {
+      for (int cards = 1; cards < CardBits::MAX_COMBINATION; ++cards) {
+         uint32_t total = CardBits::CHOOSE[cards][CardBits::DECK_SIZE];
+         bool matched = true;
+         for (uint32_t index = 0; index < total; ++index) {
+            CardMask set = CardBits::unrankCombination(index, cards);
+            matched = matched && CardBits::count(set) == cards &&
+                      CardBits::rankCombination(set) == index;
+         }
+         REQUIRE(matched);
+      }
+      REQUIRE(CardBits::rankCombination(Test::toMask("AS")) == 51);
+   }
+
+   /**
+    * @brief Index ranges split the hands into disjoint shards.
+    */
+   SECTION("Shards")
+   {
+      const uint32_t shards = 7;
+      const uint32_t width = CardBits::HAND_COMBINATIONS / shards + 1;
+      int flushes = 0;
+      for (uint32_t shard = 0; shard < shards; ++shard) {
+         uint32_t last = min(width * (shard + 1), CardBits::HAND_COMBINATIONS);
+         for (uint32_t index = width * shard; index < last; ++index) {
+            CardMask hand = CardBits::unrankCombination(index);
+            for (int suit = 0; suit < CardBits::SUIT_COUNT; ++suit) {
+               unsigned ranks = CardBits::getSuitRanks(hand, suit);
+               flushes += CardBits::count(ranks) == 5;
+            }
+         }
+      }
+      REQUIRE(flushes == 4 * 1287);
+   }
+}
+
+/**
+ * @brief Test section for verifying mask accessors on collections.
+ */
+TEST_CASE("Test Collection Masks")
+{
+   /**
+    * @brief A full deck holds every card.
+    */
+   SECTION("Deck")
+   {
+      Deck deck;
+      REQUIRE(deck.getMask() == CardBits::FULL_DECK);
+      CardPtr card = deck.deal();
+      REQUIRE(deck.contains(card->getId()) == false);
+      CardMask dealt = CardBits::toMask(card->getId());
+      REQUIRE(deck.getMask() == (CardBits::FULL_DECK & ~dealt));
+   }
+
+   /**
+    * @brief Collections convert to and from masks.
+    */
+   SECTION("Conversion")
+   {
+      CardMask mask = Test::toMask("AS KD 7H 2C");
+      CardCollection cards(mask);
+      REQUIRE(cards.size() == 4);
+      REQUIRE(cards.getMask() == mask);
+      cards.removeCards(Test::toMask("KD 2C 3C"));
+      REQUIRE(cards.getMask() == Test::toMask("AS 7H"));
+   }
+
+   /**
+    * @brief Poker hands expose their cards and reject duplicates.
+    */
+   SECTION("Poker Hand")
+   {
+      PokerHand hand("AS KS QS JS TS");
+      REQUIRE(hand.getMask() == Test::toMask("AS KS QS JS TS"));
+      vector<CardPtr> cards = {
+          make_shared<Card>("2D"),
+          make_shared<Card>("2D"),
+          make_shared<Card>("AS"),
+          make_shared<Card>("7C"),
+          make_shared<Card>("KD")
+      };
+      REQUIRE(PokerHand(cards).isValid() == false);
+   }
+}
+
+/**
+ * @brief Test section for verifying the shared canonical cards.
+ */
+TEST_CASE("Test Canonical Cards")
+{
+   /**
+    * @brief Decks, parsed hands and masks share the canonical cards.
+    */
+   SECTION("Shared Cards")
+   {
+      Deck deck;
+      for (int id = 0; id < CardBits::DECK_SIZE; ++id) {
+         REQUIRE(deck.get(id) == Card::get(static_cast<CardId>(id)));
+      }
+      PokerHand hand("AS KS QS JS TS");
+      REQUIRE(hand.get(0) == Card::get(hand.get(0)->getId()));
+      CardCollection cards(Test::toMask("2C 3D"));
+      REQUIRE(cards.get(1) == Card::get(CardBits::toId('3', 'D')));
+      REQUIRE_THROWS_AS(Card::get(CardBits::DECK_SIZE), std::out_of_range);
+   }
+
+   /**
+    * @brief Dealing and resetting keep the deck's set of cards consistent.
+    */
+   SECTION("Deal And Reset")
+   {
+      Deck deck;
+      CardPtr top = deck.get(deck.size() - 1);
+      REQUIRE(deck.deal() == top);
+      REQUIRE(deck.size() == 51);
+      deck.add(top);
+      REQUIRE(deck.getMask() == CardBits::FULL_DECK);
+      deck.removeCards(Test::toMask("AS AD AH AC"));
+      REQUIRE(deck.size() == 48);
+      deck.reset();
+      REQUIRE(deck.size() == 52);
+      REQUIRE(deck.getMask() == CardBits::FULL_DECK);
+      REQUIRE(Deck(true).isEmpty() == true);
+   }
+
+   /**
+    * @brief Burned cards leave the deck and discards return beneath it.
+    */
+   SECTION("Burn And Recycle")
+   {
+      Deck deck, discards(true);
+      REQUIRE(deck.burn() == CardBits::toId('A', 'S'));
+      REQUIRE(deck.size() == 51);
+      for (int i = 0; i < 10; ++i) {
+         discards.add(deck.deal());
+      }
+      CardId top = deck.getId(deck.size() - 1);
+      discards.add(Card::get(top)); ///< Already in the deck
+      REQUIRE(discards.size() == 11);
+
+      deck.recycle(discards);
+      REQUIRE(discards.isEmpty() == true);
+      REQUIRE(discards.getMask() == 0);
+      REQUIRE(deck.size() == 51);
+      REQUIRE(deck.getId(deck.size() - 1) == top);
+      REQUIRE(deck.getId(0) == CardBits::toId('K', 'S'));
+      REQUIRE(deck.getMask() == (CardBits::FULL_DECK & ~Test::toMask("AS")));
+
+      deck.add(Card::get(top));
+      REQUIRE(deck.size() == 51);
+      deck.clear();
+      REQUIRE(deck.burn() == CardBits::INVALID_ID);
+      REQUIRE(deck.deal() == nullptr);
+   }
+
+   /**
+    * @brief Orientation belongs to the collection holding a card.
+    */
+   SECTION("Orientation")
+   {
+      const CardPtr &ace = Card::get(CardBits::toId('A', 'S'));
+      CardCollection shown, hidden;
+      shown.add(ace, Card::FACE_UP);
+      hidden.add(ace, Card::FACE_DOWN);
+      REQUIRE(shown.getOrientation(ace->getId()) == Card::FACE_UP);
+      REQUIRE(hidden.getOrientation(ace->getId()) == Card::FACE_DOWN);
+      shown.remove(ace);
+      REQUIRE(shown.getOrientation(ace->getId()) == Card::FACE_DOWN);
+
+      auto hand = make_shared<PokerHand>();
+      hand->add(ace, Card::FACE_UP);
+      REQUIRE(hand->getOrientation(ace->getId()) == Card::FACE_UP);
+   }
+}
+
+/**
+ * @brief Test section for verifying seeded shuffles.
+ */
+TEST_CASE("Test Deck Shuffle")
+{
+   /**
+    * @brief The same seed deals the same cards, and a shuffle keeps them.
+    */
+   SECTION("Seeded")
+   {
+      Deck first, second;
+      first.seed(42);
+      second.seed(42);
+      first.shuffle();
+      second.shuffle();
+      bool moved = false;
+      for (int i = 0; i < CardBits::DECK_SIZE; ++i) {
+         REQUIRE(first.getId(i) == second.getId(i));
+         moved |= first.getId(i) != i;
+      }
+      REQUIRE(moved == true);
+      REQUIRE(first.getMask() == CardBits::FULL_DECK);
+
+      second.seed(43);
+      second.reset();
+      second.shuffle();
+      bool differs = false;
+      for (int i = 0; i < CardBits::DECK_SIZE; ++i) {
+         differs |= first.getId(i) != second.getId(i);
+      }
+      REQUIRE(differs == true);
+   }
+
+   /**
+    * @brief A partial shuffle only reorders what it needs to.
+    */
+   SECTION("Partial")
+   {
+      Deck deck;
+      deck.seed(7);
+      deck.shuffle(5);
+      REQUIRE(deck.size() == 52);
+      REQUIRE(deck.getMask() == CardBits::FULL_DECK);
+      ///< Five swaps move at most ten cards
+      int moved = 0;
+      for (int i = 0; i < CardBits::DECK_SIZE; ++i) {
+         moved += deck.getId(i) != i;
+      }
+      REQUIRE(moved <= 10);
+
+      Deck single(true);
+      single.add(Card::get(0));
+      single.shuffle(5);
+      REQUIRE(single.getId(0) == 0);
+   }
+   /**
+    * @brief A stacked deck deals the given cards first, in order.
+    */
+   SECTION("Stacked")
+   {
+      Deck deck;
+      deck.seed(3);
+      deck.shuffle();
+      const CardId order[] = {51, 0, 26, 13};
+      REQUIRE(deck.stack(order, 4) == 4);
+      REQUIRE(deck.getMask() == CardBits::FULL_DECK);
+      for (CardId id : order) {
+         REQUIRE(deck.deal()->getId() == id);
+      }
+
+      ///< Stops at a card already dealt, or repeated
+      const CardId missing[] = {7, 0, 8};
+      REQUIRE(deck.stack(missing, 3) == 1);
+      const CardId repeated[] = {9, 9};
+      REQUIRE(deck.stack(repeated, 2) == 1);
+      REQUIRE(deck.deal()->getId() == 9);
+   }
+}
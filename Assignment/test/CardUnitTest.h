@@ -0,0 +1,29 @@
+/**
+ * @file test/CardUnitTest.h
+ * @brief Tester class for cards and card collections.
+ */
+
+#ifndef CARDUNITTEST_H
+#define CARDUNITTEST_H
+
+#include "../src/game/resources/CardBits.h"
+#include "../src/game/resources/CardCollection.h"
+#include <string>
+
+/**
+ * @class CardUnitTest
+ * @brief Tester class for cards and card collections.
+ */
+class CardUnitTest
+{
+ public:
+   /**
+    * @brief Builds a card mask from space separated card tokens.
+    *
+    * @param notation The card tokens, e.g. "AS KS".
+    * @return CardMask The set of cards.
+    */
+   static CardMask toMask(const std::string &notation);
+};
+
+#endif // CARDUNITTEST_H
@@ -0,0 +1,454 @@
+/**
+ * @file test/DrawEquityUnitTest.cpp
+ * @brief Unit tests for the DrawEquity class and its thread pool.
+ */
+#include "./DrawEquityUnitTest.h"
+#include "../../catch_amalgamated.hpp"
+#include "../src/game/analysis/DrawEquity.h"
+#include "../src/game/analysis/DrawOptimizer.h"
+#include "../src/game/analysis/DrawTable.h"
+#include "../src/game/player/AIPokerPlayer.h"
+#include "../src/game/resources/HandEvaluator.h"
+#include "../src/game/resources/Card.h"
+#include "../utils/ThreadPool.h"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using Test = DrawEquityUnitTest;
+using HandPtr = std::shared_ptr<PokerHand>;
+using namespace std;
+
+/**
+ * @brief Find card indices.
+ *
+ * @param hand
+ * @param names
+ * @return vector<int>
+ */
+vector<int> Test::indexOf(const HandPtr &hand, const vector<string> &names)
+{
+   vector<int> idxs;
+   for (const auto &name : names) {
+      for (int i = 0; i < static_cast<int>(hand->size()); ++i) {
+         if (hand->get(i)->getName() == name) {
+            idxs.push_back(i);
+         }
+      }
+   }
+   return idxs;
+}
+
+/**
+ * @brief Build dead cards.
+ *
+ * @param hand
+ * @param live
+ * @return CardCollection
+ */
+CardCollection Test::deadExcept(const HandPtr &hand, const string &live)
+{
+   istringstream iss(live);
+   string token;
+   CardMask mask = hand->getMask();
+   while (iss >> token) {
+      mask |= CardBits::toMask(Card(token).getId());
+   }
+   return CardCollection(CardBits::FULL_DECK & ~mask);
+}
+
+/**
+ * @brief Enumerate every draw.
+ *
+ * @param ids
+ * @param pattern
+ * @param categories
+ * @return double
+ */
+double Test::enumerateDraws(
+    const CardId *ids, unsigned pattern, array<uint32_t, 9> *categories
+)
+{
+   CardMask hand = 0, kept = 0;
+   for (int i = 0; i < 5; ++i) {
+      hand |= CardBits::toMask(ids[i]);
+      if (!(pattern >> i & 1)) {
+         kept |= CardBits::toMask(ids[i]);
+      }
+   }
+   vector<CardId> stub;
+   for (CardId id = 0; id < CardBits::DECK_SIZE; ++id) {
+      if (!CardBits::contains(hand, id)) {
+         stub.push_back(id);
+      }
+   }
+   int draws = 5 - CardBits::count(kept);
+   double total = 0, count = 0;
+   vector<int> pick(draws);
+   ///< Walk the draws as ascending index tuples into the stub
+   for (int i = 0; i < draws; ++i) {
+      pick[i] = i;
+   }
+   while (true) {
+      CardMask final = kept;
+      for (int idx : pick) {
+         final |= CardBits::toMask(stub[idx]);
+      }
+      uint16_t rank = HandEvaluator::evaluate(final);
+      total += rank;
+      if (categories) {
+         ++(*categories)[HandEvaluator::getCategory(rank)];
+      }
+      count++;
+      int i = draws - 1;
+      while (i >= 0 && pick[i] == static_cast<int>(stub.size()) - draws + i) {
+         --i;
+      }
+      if (i < 0) {
+         break;
+      }
+      ++pick[i];
+      for (int j = i + 1; j < draws; ++j) {
+         pick[j] = pick[j - 1] + 1;
+      }
+   }
+   return total / count;
+}
+
+/**
+ * @brief Test section for verifying the thread pool.
+ */
+TEST_CASE("Test Thread Pool")
+{
+   ThreadPool pool(3);
+   REQUIRE(pool.size() == 3);
+
+   vector<future<int>> results;
+   for (int i = 0; i < 100; ++i) {
+      results.push_back(pool.submit([i]() { return i * i; }));
+   }
+   long sum = 0;
+   for (auto &result : results) {
+      sum += result.get();
+   }
+   REQUIRE(sum == 328350);
+}
+
+/**
+ * @brief Test section for verifying draw equity estimates.
+ */
+TEST_CASE("Test Draw Equity")
+{
+   DrawEquity equity(2);
+   CardCollection none;
+
+   /**
+    * @brief With six live cards the odds are exact.
+    */
+   SECTION("Known Odds")
+   {
+      ///< Only 6H wins: a straight against kings and jacks
+      auto hand = make_shared<PokerHand>("2C 3D 4H 5S 9C");
+      auto dead = Test::deadExcept(hand, "6H JC JD KC KD QC");
+      auto result = equity.calculate(
+          hand, Test::indexOf(hand, {"9C"}), 1, dead, 60000, 1
+      );
+      REQUIRE(result.samples == 60000);
+      REQUIRE(abs(result.win - 1.0 / 6) < 0.01);
+      REQUIRE(result.tie == 0);
+      REQUIRE(abs(result.loss - 5.0 / 6) < 0.01);
+   }
+
+   /**
+    * @brief A royal flush standing pat can only be tied.
+    */
+   SECTION("Royal Flush")
+   {
+      auto hand = make_shared<PokerHand>("AS KS QS JS TS");
+      auto result = equity.calculate(hand, {}, 3, none, 20000);
+      REQUIRE(result.loss == 0);
+      REQUIRE(result.win > 0.999);
+   }
+
+   /**
+    * @brief A seed gives the same odds on any number of threads.
+    */
+   SECTION("Reproducible")
+   {
+      DrawEquity single(1);
+      auto hand = make_shared<PokerHand>("7H 7D KC 4S 2D");
+      vector<int> discards = Test::indexOf(hand, {"KC", "4S", "2D"});
+      auto a = equity.calculate(hand, discards, 3, none, 50000, 42);
+      auto b = single.calculate(hand, discards, 3, none, 50000, 42);
+      auto c = single.calculate(hand, discards, 3, none, 50000, 43);
+      REQUIRE(a.win == b.win);
+      REQUIRE(a.tie == b.tie);
+      REQUIRE(a.loss == b.loss);
+      REQUIRE(a.win != c.win);
+      REQUIRE(abs(a.win + a.tie + a.loss - 1) < 1e-9);
+      REQUIRE(abs(a.win - c.win) < 0.02);
+   }
+
+   /**
+    * @brief A time budget samples until it runs out.
+    */
+   SECTION("Time Budget")
+   {
+      auto hand = make_shared<PokerHand>("7H 7D KC 4S 2D");
+      auto result = equity.calculate(
+          hand, {}, 2, none, chrono::microseconds(2000)
+      );
+      REQUIRE(result.samples > 0);
+      REQUIRE(abs(result.win + result.tie + result.loss - 1) < 1e-9);
+   }
+
+   /**
+    * @brief Invalid requests return no samples.
+    */
+   SECTION("Invalid Requests")
+   {
+      auto hand = make_shared<PokerHand>("7H 7D KC 4S 2D");
+      REQUIRE(equity.calculate(hand, {}, 0, none, 100).samples == 0);
+      REQUIRE(equity.calculate(hand, {}, 10, none, 100).samples == 0);
+      REQUIRE(equity.calculate(hand, {5}, 1, none, 100).samples == 0);
+      REQUIRE(equity.calculate(hand, {1, 1}, 1, none, 100).samples == 0);
+      REQUIRE(equity.calculate(hand, {}, 1, none, 0).samples == 0);
+      auto dead = Test::deadExcept(hand, "AC AD KD");
+      REQUIRE(equity.calculate(hand, {0}, 1, dead, 100).samples == 0);
+      auto partial = make_shared<PokerHand>("7H 7D KC 4S");
+      REQUIRE(equity.calculate(partial, {}, 1, none, 100).samples == 0);
+   }
+}
+
+/**
+ * @brief Test section for verifying the exhaustive discard optimizer.
+ */
+TEST_CASE("Test Draw Optimizer")
+{
+   /**
+    * @brief Every pattern scores the mean of enumerating its draws.
+    */
+   SECTION("Exact Scores")
+   {
+      for (string notation : {"7H 7D KC 4S 2D", "AH KH QH JH 2C"}) {
+         auto hand = make_shared<PokerHand>(notation);
+         CardId ids[5];
+         for (int i = 0; i < 5; ++i) {
+            ids[i] = hand->get(i)->getId();
+         }
+         auto scores = DrawOptimizer::score(ids);
+         REQUIRE(scores[DrawOptimizer::STAND_PAT] == hand->getScore());
+         for (unsigned pattern = 0; pattern < DrawOptimizer::PATTERNS;
+              ++pattern) {
+            double expected = Test::enumerateDraws(ids, pattern);
+            REQUIRE(abs(scores[pattern] - expected) < 1e-9 * expected);
+         }
+      }
+   }
+
+   /**
+    * @brief The best pattern beats keeping pairs and standing pat.
+    */
+   SECTION("Best Discard")
+   {
+      auto draw = make_shared<PokerHand>("AH KH QH JH 2C");
+      REQUIRE(
+          DrawOptimizer::discard(draw) == Test::indexOf(draw, {"2C"})
+      );
+      auto royal = make_shared<PokerHand>("AS KS QS JS TS");
+      REQUIRE(DrawOptimizer::discard(royal).empty());
+
+      CardId ids[5];
+      auto pair = make_shared<PokerHand>("7H 7D KC 4S 2D");
+      for (int i = 0; i < 5; ++i) {
+         ids[i] = pair->get(i)->getId();
+      }
+      auto choice = DrawOptimizer::best(ids);
+      auto scores = DrawOptimizer::score(ids);
+      for (double score : scores) {
+         REQUIRE(choice.expected >= score);
+      }
+      REQUIRE(choice.expected > scores[DrawOptimizer::STAND_PAT]);
+      REQUIRE(DrawOptimizer::toIndices(choice.pattern).size() <= 5);
+
+      auto partial = make_shared<PokerHand>("7H 7D KC 4S");
+      REQUIRE(DrawOptimizer::discard(partial).empty());
+   }
+
+   /**
+    * @brief An optimizing AI player discards what the optimizer picks.
+    */
+   SECTION("Optimizing Player")
+   {
+      using Strategy = AIPokerPlayer::Strategy;
+      AIPokerPlayer player(nullptr, 1, 100.0, Strategy::OPTIMIZING);
+      auto hand = make_shared<PokerHand>("AH KH QH JH 2C");
+      CardCollection dealt;
+      for (int i = 0; i < 5; ++i) {
+         dealt.add(hand->get(i));
+      }
+      player.receive(dealt);
+      REQUIRE(
+          player.discard() == DrawOptimizer::discard(player.show().playerHand)
+      );
+      REQUIRE(player.discard().size() == 1);
+   }
+}
+
+/**
+ * @brief Test section for verifying the mapped draw outcome table.
+ */
+TEST_CASE("Test Draw Table")
+{
+   const uint32_t classes = 300;
+   const string path =
+       (filesystem::temp_directory_path() / "draw_table_test.pkdt").string();
+   REQUIRE(DrawTable::generate(path, classes));
+   REQUIRE(
+       filesystem::file_size(path) ==
+       DrawTable::HEADER_SIZE + size_t{classes} * DrawTable::CLASS_SIZE
+   );
+   DrawTable table;
+   REQUIRE(table.open(path));
+   REQUIRE(table.getClassCount() == classes);
+
+   /**
+    * @brief Every record matches the optimizer and counts every draw.
+    */
+   SECTION("Records")
+   {
+      const uint32_t draws[] = {1, 47, 1081, 16215, 178365, 1533939};
+      long mismatches = 0;
+      for (uint32_t index = 0; index < classes; ++index) {
+         CardMask hand = SuitIsomorphism::unindex(index);
+         CardId ids[5];
+         for (auto &id : ids) {
+            id = CardBits::popLowest(hand);
+         }
+         auto scores = DrawOptimizer::score(ids);
+         for (unsigned pattern = 0; pattern < DrawTable::PATTERNS; ++pattern) {
+            auto outcome = table.lookup(ids, pattern);
+            if (outcome.draws != draws[popcount(pattern)] ||
+                outcome.expected != scores[pattern]) {
+               ++mismatches;
+            }
+         }
+      }
+      REQUIRE(mismatches == 0);
+
+      ///< Category counts against enumerating the draws
+      CardId ids[5];
+      CardMask hand = SuitIsomorphism::unindex(classes - 1);
+      for (auto &id : ids) {
+         id = CardBits::popLowest(hand);
+      }
+      for (unsigned pattern : {0u, 1u, 6u, 21u, 28u}) {
+         array<uint32_t, 9> categories{};
+         Test::enumerateDraws(ids, pattern, &categories);
+         REQUIRE(table.lookup(ids, pattern).categories == categories);
+      }
+   }
+
+   /**
+    * @brief Hands are found under any suits and card order.
+    */
+   SECTION("Relabeled Hands")
+   {
+      CardMask canonical = SuitIsomorphism::unindex(123);
+      CardId ids[5];
+      for (auto &id : ids) {
+         id = CardBits::popLowest(canonical);
+      }
+      ///< Swap clubs with hearts, and reverse the cards
+      CardId moved[5];
+      for (int i = 0; i < 5; ++i) {
+         int suit = CardBits::getSuit(ids[4 - i]);
+         suit = suit == 0 ? 2 : suit == 2 ? 0 : suit;
+         moved[i] = CardBits::makeId(CardBits::getRank(ids[4 - i]), suit);
+      }
+      for (unsigned pattern = 0; pattern < DrawTable::PATTERNS; ++pattern) {
+         unsigned reversed = 0;
+         for (int i = 0; i < 5; ++i) {
+            reversed |= (pattern >> i & 1) << (4 - i);
+         }
+         auto expected = table.lookup(ids, pattern);
+         auto outcome = table.lookup(moved, reversed);
+         REQUIRE(outcome.categories == expected.categories);
+         REQUIRE(outcome.expected == expected.expected);
+      }
+
+      DrawOptimizer::Choice fromTable;
+      REQUIRE(table.best(moved, fromTable));
+      auto computed = DrawOptimizer::best(moved);
+      REQUIRE(fromTable.pattern == computed.pattern);
+      REQUIRE(fromTable.expected == computed.expected);
+   }
+
+   /**
+    * @brief Hands past the generated classes fall back to computing.
+    */
+   SECTION("Missing Hands")
+   {
+      auto hand = make_shared<PokerHand>("AH KH QH JH 2C");
+      REQUIRE(SuitIsomorphism::index(hand->getMask()) >= classes);
+      REQUIRE(table.lookup(hand, {4}).draws == 0);
+      REQUIRE(table.discard(hand) == DrawOptimizer::discard(hand));
+      REQUIRE(table.lookup(make_shared<PokerHand>("AH KH"), {}).draws == 0);
+   }
+
+   /**
+    * @brief Files that are not current tables are refused.
+    */
+   SECTION("Bad Files")
+   {
+      DrawTable other;
+      REQUIRE_FALSE(other.open(path + ".missing"));
+      {
+         ofstream truncated(path + ".bad", ios::binary);
+         ifstream whole(path, ios::binary);
+         string bytes(DrawTable::HEADER_SIZE + 100, '\0');
+         whole.read(bytes.data(), bytes.size());
+         truncated.write(bytes.data(), bytes.size());
+      }
+      REQUIRE_FALSE(other.open(path + ".bad"));
+      REQUIRE_FALSE(other.isOpen());
+      filesystem::remove(path + ".bad");
+   }
+
+   /**
+    * @brief An installed table is shared, and used by optimizing players.
+    */
+   SECTION("Shared Table")
+   {
+      DrawTable::install(path);
+      auto shared = DrawTable::shared();
+      REQUIRE(shared);
+      REQUIRE(shared == DrawTable::shared());
+      REQUIRE(shared->getClassCount() == classes);
+
+      using Strategy = AIPokerPlayer::Strategy;
+      AIPokerPlayer player(nullptr, 1, 100.0, Strategy::OPTIMIZING);
+      CardMask canonical = SuitIsomorphism::unindex(classes / 2);
+      CardCollection dealt;
+      while (canonical) {
+         dealt.add(Card::get(CardBits::popLowest(canonical)));
+      }
+      player.receive(dealt);
+      auto hand = player.show().playerHand;
+      REQUIRE(player.discard() == shared->discard(hand));
+      REQUIRE(player.discard() == DrawOptimizer::discard(hand));
+
+      ///< The equity API answers draw questions from the same table
+      auto outcome = DrawEquity::distribution(hand, {0, 4});
+      REQUIRE(outcome.draws == 1081);
+      REQUIRE(outcome.categories == shared->lookup(hand, {0, 4}).categories);
+
+      DrawTable::install("");
+      REQUIRE_FALSE(DrawTable::shared());
+      REQUIRE(DrawEquity::distribution(hand, {0, 4}).draws == 0);
+      REQUIRE(shared->isOpen());
+   }
+   filesystem::remove(path);
+}
@@ -0,0 +1,62 @@
+/**
+ * @file test/DrawEquityUnitTest.h
+ * @brief Tester class for the Monte Carlo draw equity calculator.
+ */
+
+#ifndef DRAWEQUITYUNITTEST_H
+#define DRAWEQUITYUNITTEST_H
+
+#include "../src/game/resources/CardBits.h"
+#include "../src/game/resources/CardCollection.h"
+#include "../src/game/resources/PokerHand.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class DrawEquityUnitTest
+ * @brief Tester class for the Monte Carlo draw equity calculator.
+ */
+class DrawEquityUnitTest
+{
+ public:
+   /**
+    * @brief Finds the indices of cards within a hand.
+    *
+    * @param hand The hand.
+    * @param names The card names to find, e.g. {"9C"}.
+    * @return std::vector<int> The index of each card in the hand.
+    */
+   static std::vector<int> indexOf(
+       const std::shared_ptr<PokerHand> &hand,
+       const std::vector<std::string> &names
+   );
+
+   /**
+    * @brief Builds the dead cards that leave only the given cards live.
+    *
+    * @param hand The hand, which is never dead.
+    * @param live The card names left to deal, e.g. "6H AC".
+    * @return CardCollection Every other card.
+    */
+   static CardCollection deadExcept(
+       const std::shared_ptr<PokerHand> &hand, const std::string &live
+   );
+
+   /**
+    * @brief Averages the final class rank over every draw of a discard.
+    *
+    * @param ids The five card ids, in hand order.
+    * @param pattern The discard pattern, one bit per hand index.
+    * @param categories If set, receives the draws ending in each category.
+    * @return double The mean final class rank.
+    */
+   static double enumerateDraws(
+       const CardId *ids, unsigned pattern,
+       std::array<std::uint32_t, 9> *categories = nullptr
+   );
+};
+
+#endif // DRAWEQUITYUNITTEST_H
@@ -0,0 +1,391 @@
+/**
+ * @file test/HandEvaluatorUnitTest.cpp
+ * @brief Unit tests for the HandEvaluator class.
+ */
+#include "./HandEvaluatorUnitTest.h"
+#include "../../catch_amalgamated.hpp"
+#include "../src/game/resources/Card.h"
+#include "../src/game/resources/HandEvaluator.h"
+#include "../src/game/resources/HandStrength.h"
+#include "../src/game/resources/PokerHand.h"
+#include <algorithm>
+#include <bitset>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using Test = HandEvaluatorUnitTest;
+using Category = PokerHand::Category;
+using namespace std;
+
+std::array<std::string, 9> Test::lowest = {
+    "2D 3H 4S 5C 7H", // High card
+    "2D 2H 3S 4C 5H", // One pair
+    "2D 2H 3S 3C 4H", // Two pair
+    "2D 2H 2S 3C 4H", // Three of a kind
+    "AD 2H 3C 4S 5H", // Straight
+    "2D 3D 4D 5D 7D", // Flush
+    "2D 2H 2S 3C 3H", // Full house
+    "2D 2H 2S 2C 3H", // Four of a kind
+    "AS 2S 3S 4S 5S", // Straight flush
+};
+
+std::array<long, 9> Test::frequency = {
+    1302540, 1098240, 123552, 54912, 10200, 5108, 3744, 624, 40
+};
+
+/**
+ * @brief Evaluate a hand notation.
+ *
+ * @param notation
+ * @return std::uint16_t
+ */
+uint16_t Test::evaluate(const string &notation)
+{
+   istringstream iss(notation);
+   string token;
+   vector<uint32_t> codes;
+   CardMask mask = 0;
+   while (iss >> token) {
+      codes.push_back(HandEvaluator::encode(Card(token)));
+      mask |= CardBits::toMask(Card(token).getId());
+   }
+   if (codes.size() > 5) {
+      return HandEvaluator::evaluate(mask);
+   }
+   return HandEvaluator::evaluate(
+       codes.at(0), codes.at(1), codes.at(2), codes.at(3), codes.at(4)
+   );
+}
+
+/**
+ * @brief Deal a random set of cards.
+ *
+ * @param rng
+ * @param count
+ * @return CardMask
+ */
+CardMask Test::deal(mt19937_64 &rng, int count)
+{
+   CardMask mask = 0;
+   while (CardBits::count(mask) < count) {
+      mask |= CardBits::toMask(rng() % CardBits::DECK_SIZE);
+   }
+   return mask;
+}
+
+/**
+ * @brief Rank the best five card subset by brute force.
+ *
+ * @param mask
+ * @return std::uint16_t
+ */
+uint16_t Test::bestOfFive(CardMask mask)
+{
+   vector<uint32_t> codes;
+   while (mask) {
+      codes.push_back(HandEvaluator::encode(CardBits::popLowest(mask)));
+   }
+   uint16_t best = 0;
+   vector<bool> pick(codes.size(), false);
+   fill(pick.begin(), pick.begin() + 5, true);
+   do {
+      vector<uint32_t> hand;
+      for (size_t i = 0; i < codes.size(); ++i) {
+         if (pick[i]) {
+            hand.push_back(codes[i]);
+         }
+      }
+      best = max(
+          best,
+          HandEvaluator::evaluate(hand[0], hand[1], hand[2], hand[3], hand[4])
+      );
+   } while (prev_permutation(pick.begin(), pick.end()));
+   return best;
+}
+
+/**
+ * @brief Test section for verifying class rank boundaries.
+ */
+TEST_CASE("Test Class Rank Boundaries")
+{
+   /**
+    * @brief The weakest and strongest hands span the full rank range.
+    */
+   SECTION("Extremes")
+   {
+      REQUIRE(Test::evaluate("7S 5D 4H 3C 2D") == 1);
+      REQUIRE(Test::evaluate("AS KS QS JS TS") == HandEvaluator::CLASS_COUNT);
+   }
+
+   /**
+    * @brief The lowest hand of each category sits on the category floor.
+    */
+   SECTION("Category Floors")
+   {
+      for (int i = 0; i < 9; ++i) {
+         uint16_t rank = Test::evaluate(Test::lowest[i]);
+         REQUIRE(rank == HandEvaluator::CATEGORY_FLOOR[i]);
+         REQUIRE(HandEvaluator::getCategory(rank) == i);
+         if (i > 0) {
+            REQUIRE(HandEvaluator::getCategory(rank - 1) == i - 1);
+         }
+      }
+      REQUIRE(HandEvaluator::getCategory(0) == Category::INVALID_HAND);
+   }
+
+   /**
+    * @brief Suits only matter when they make a flush.
+    */
+   SECTION("Suit Independence")
+   {
+      REQUIRE(
+          Test::evaluate("KD KS 7D 7H 8H") == Test::evaluate("KC KS 7C 7H 8C")
+      );
+      REQUIRE(
+          Test::evaluate("TD 8D 7D 6D 5D") == Test::evaluate("TS 8S 7S 6S 5S")
+      );
+   }
+}
+
+/**
+ * @brief Test section for verifying every five card hand.
+ */
+TEST_CASE("Test Exhaustive Evaluation")
+{
+   array<long, 9> histogram = {0};
+   bitset<HandEvaluator::CLASS_COUNT + 1> seen;
+   uint32_t deck[52];
+   for (int suit = 0; suit < 4; ++suit) {
+      for (int rank = 0; rank < 13; ++rank) {
+         deck[suit * 13 + rank] = HandEvaluator::encode(rank, suit);
+      }
+   }
+   for (int a = 0; a < 52; ++a) {
+      for (int b = a + 1; b < 52; ++b) {
+         for (int c = b + 1; c < 52; ++c) {
+            for (int d = c + 1; d < 52; ++d) {
+               for (int e = d + 1; e < 52; ++e) {
+                  uint16_t rank = HandEvaluator::evaluate(
+                      deck[a], deck[b], deck[c], deck[d], deck[e]
+                  );
+                  histogram[HandEvaluator::getCategory(rank)]++;
+                  seen.set(rank);
+               }
+            }
+         }
+      }
+   }
+   REQUIRE(histogram == Test::frequency);
+   REQUIRE(seen.count() == HandEvaluator::CLASS_COUNT);
+}
+
+/**
+ * @brief Test section for verifying class percentiles and win odds.
+ */
+TEST_CASE("Test Hand Strength")
+{
+   vector<uint32_t> sizes(HandEvaluator::CLASS_COUNT + 1, 0);
+   const CardMask end = CardMask{1} << 52;
+   for (CardMask hand = 0x1F; hand < end;) {
+      sizes[HandEvaluator::evaluate(hand)]++;
+      hand = CardBits::nextCombination(hand);
+   }
+
+   /**
+    * @brief Class sizes and counts below match every hand evaluated.
+    */
+   SECTION("Percentiles")
+   {
+      uint32_t below = 0, mismatches = 0;
+      double previous = 0;
+      for (uint16_t rank = 1; rank <= HandEvaluator::CLASS_COUNT; ++rank) {
+         if (HandStrength::getClassSize(rank) != sizes[rank] ||
+             HandStrength::getHandsBelow(rank) != below ||
+             HandStrength::getPercentile(rank) <= previous) {
+            ++mismatches;
+         }
+         previous = HandStrength::getPercentile(rank);
+         below += sizes[rank];
+      }
+      REQUIRE(mismatches == 0);
+      REQUIRE(below == HandStrength::HANDS);
+      REQUIRE(HandStrength::getPercentile(1) == Approx(510.0 / 2598960));
+      REQUIRE(HandStrength::getPercentile(7462) == Approx(1 - 2.0 / 2598960));
+      REQUIRE(HandStrength::getClassSize(0) == 0);
+      REQUIRE(HandStrength::getPercentile(7463) == 0);
+   }
+
+   /**
+    * @brief Win odds match the pot share against independent hands.
+    */
+   SECTION("Win Probabilities")
+   {
+      auto pair = static_cast<uint16_t>(PokerHand("2D 2H 3S 4C 5H").getScore());
+      auto aces = static_cast<uint16_t>(PokerHand("AD AH KS QC JH").getScore());
+      for (uint16_t rank : {uint16_t(1), pair, aces, uint16_t(6000)}) {
+         double beaten = HandStrength::getHandsBelow(rank) / 2598960.0;
+         double tied = HandStrength::getClassSize(rank) / 2598960.0;
+         REQUIRE(
+             HandStrength::getWinProbability(rank, 1) ==
+             Approx(HandStrength::getPercentile(rank))
+         );
+         REQUIRE(
+             HandStrength::getWinProbability(rank, 2) ==
+             Approx(beaten * beaten + beaten * tied + tied * tied / 3)
+         );
+         for (int k = 2; k <= HandStrength::MAX_OPPONENTS; ++k) {
+            REQUIRE(
+                HandStrength::getWinProbability(rank, k) <
+                HandStrength::getWinProbability(rank, k - 1)
+            );
+         }
+      }
+      REQUIRE(
+          HandStrength::getWinProbability(aces, 3) >
+          HandStrength::getWinProbability(pair, 1)
+      );
+      REQUIRE(HandStrength::getWinProbability(pair, 0) == 0);
+      REQUIRE(HandStrength::getWinProbability(pair, 7) == 0);
+      REQUIRE(HandStrength::getWinProbability(0, 1) == 0);
+   }
+}
+
+/**
+ * @brief Test section for verifying best five of six and seven cards.
+ */
+TEST_CASE("Test Community Card Evaluation")
+{
+   /**
+    * @brief Five card masks rank the same as encoded five card hands.
+    */
+   SECTION("Five Card Masks")
+   {
+      mt19937_64 rng(5);
+      for (int i = 0; i < 100000; ++i) {
+         CardMask mask = Test::deal(rng, 5);
+         CardId ids[5];
+         for (CardId &id : ids) {
+            id = CardBits::popLowest(mask);
+         }
+         REQUIRE(
+             HandEvaluator::evaluate(ids, 5) ==
+             HandEvaluator::evaluate(
+                 HandEvaluator::encode(ids[0]),
+                 HandEvaluator::encode(ids[1]),
+                 HandEvaluator::encode(ids[2]),
+                 HandEvaluator::encode(ids[3]),
+                 HandEvaluator::encode(ids[4])
+             )
+         );
+      }
+   }
+
+   /**
+    * @brief Six and seven card sets rank as their best five card subset.
+    */
+   SECTION("Best Five Cards")
+   {
+      mt19937_64 rng(7);
+      for (int n = 6; n <= 7; ++n) {
+         for (int i = 0; i < 50000; ++i) {
+            CardMask mask = Test::deal(rng, n);
+            REQUIRE(HandEvaluator::evaluate(mask) == Test::bestOfFive(mask));
+         }
+      }
+   }
+
+   /**
+    * @brief Known seven card hands pick the right five cards.
+    */
+   SECTION("Known Hands")
+   {
+      uint16_t wheel = Test::evaluate("AS 2D 3H 4C 5H KS KD");
+      REQUIRE(HandEvaluator::getDescription(wheel) == "Straight");
+      REQUIRE(
+          Test::evaluate("AS AD AH KC KH KS 2D") ==
+          Test::evaluate("AS AD AH KC KH")
+      );
+      REQUIRE(
+          Test::evaluate("9S 9D 5H 5C 3H 3S 2D") ==
+          Test::evaluate("9S 9D 5H 5C 3H")
+      );
+      REQUIRE(
+          Test::evaluate("2H 3H 4H 5H 6H 7H AS") ==
+          Test::evaluate("3H 4H 5H 6H 7H")
+      );
+   }
+}
+
+/**
+ * @brief Test section for verifying the batch kernels.
+ */
+TEST_CASE("Test Batch Evaluation")
+{
+   vector<HandEvaluator::BatchKernel> kernels;
+   for (int kernel = HandEvaluator::SCALAR_KERNEL;
+        kernel <= HandEvaluator::getBatchKernel(); ++kernel) {
+      kernels.push_back(static_cast<HandEvaluator::BatchKernel>(kernel));
+   }
+
+   /**
+    * @brief Every five card hand ranks as its encoded five card hand.
+    */
+   SECTION("Every Five Card Hand")
+   {
+      vector<CardMask> masks;
+      vector<uint16_t> expected;
+      for (int a = 0; a < 52; ++a) {
+         for (int b = a + 1; b < 52; ++b) {
+            for (int c = b + 1; c < 52; ++c) {
+               for (int d = c + 1; d < 52; ++d) {
+                  for (int e = d + 1; e < 52; ++e) {
+                     masks.push_back(
+                         (1ULL << a) | (1ULL << b) | (1ULL << c) |
+                         (1ULL << d) | (1ULL << e)
+                     );
+                     expected.push_back(HandEvaluator::evaluate(
+                         HandEvaluator::encode(CardId(a)),
+                         HandEvaluator::encode(CardId(b)),
+                         HandEvaluator::encode(CardId(c)),
+                         HandEvaluator::encode(CardId(d)),
+                         HandEvaluator::encode(CardId(e))
+                     ));
+                  }
+               }
+            }
+         }
+      }
+      for (auto kernel : kernels) {
+         INFO(HandEvaluator::getBatchKernelName(kernel));
+         vector<uint16_t> ranks(masks.size());
+         HandEvaluator::evaluateBatch(
+             masks.data(), ranks.data(), masks.size(), kernel
+         );
+         REQUIRE(ranks == expected);
+      }
+   }
+
+   /**
+    * @brief Mixed six and seven card sets rank as evaluate(CardMask).
+    */
+   SECTION("Six And Seven Cards")
+   {
+      mt19937_64 rng(11);
+      vector<CardMask> masks(100003);
+      vector<uint16_t> expected(masks.size());
+      for (size_t i = 0; i < masks.size(); ++i) {
+         masks[i] = Test::deal(rng, 5 + i % 3);
+         expected[i] = HandEvaluator::evaluate(masks[i]);
+      }
+      for (auto kernel : kernels) {
+         INFO(HandEvaluator::getBatchKernelName(kernel));
+         vector<uint16_t> ranks(masks.size());
+         HandEvaluator::evaluateBatch(
+             masks.data(), ranks.data(), masks.size(), kernel
+         );
+         REQUIRE(ranks == expected);
+      }
+   }
+}
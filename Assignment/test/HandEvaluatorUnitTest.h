@@ -0,0 +1,55 @@
+/**
+ * @file test/HandEvaluatorUnitTest.h
+ * @brief Tester class for the table-driven hand evaluator.
+ */
+
+#ifndef HANDEVALUATORUNITTEST_H
+#define HANDEVALUATORUNITTEST_H
+
+#include "../src/game/resources/HandEvaluator.h"
+#include "../src/game/resources/PokerHand.h"
+#include <array>
+#include <cstdint>
+#include <random>
+#include <string>
+
+/**
+ * @class HandEvaluatorUnitTest
+ * @brief Tester class for the table-driven hand evaluator.
+ */
+class HandEvaluatorUnitTest
+{
+ public:
+   /**
+    * @brief Evaluates a hand given in notation form.
+    *
+    * @param notation Five to seven card tokens, e.g. "AS KS QS JS TS".
+    * @return std::uint16_t The class rank of the hand.
+    */
+   static std::uint16_t evaluate(const std::string &notation);
+
+   /**
+    * @brief Deals a random set of distinct cards.
+    *
+    * @param rng The random generator.
+    * @param count The number of cards.
+    * @return CardMask The set of cards.
+    */
+   static CardMask deal(std::mt19937_64 &rng, int count);
+
+   /**
+    * @brief Ranks a card set by trying every five card subset.
+    *
+    * @param mask The set of cards.
+    * @return std::uint16_t The best class rank.
+    */
+   static std::uint16_t bestOfFive(CardMask mask);
+
+   ///< Lowest hand of each category, indexed by PokerHand::Category.
+   static std::array<std::string, 9> lowest;
+
+   ///< Number of five card hands in each category.
+   static std::array<long, 9> frequency;
+};
+
+#endif // HANDEVALUATORUNITTEST_H
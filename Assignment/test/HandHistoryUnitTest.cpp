@@ -0,0 +1,393 @@
+/**
+ * @file test/HandHistoryUnitTest.cpp
+ * @brief Unit tests for the HistoryWriter and HistoryReader classes.
+ */
+#include "./HandHistoryUnitTest.h"
+#include "../../catch_amalgamated.hpp"
+#include "../src/game/PokerEngine.h"
+#include "../src/game/history/HistoryReader.h"
+#include "../src/game/history/HistoryWriter.h"
+#include "../src/game/player/AIPokerPlayer.h"
+#include "../src/game/simulation/Replay.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+using Test = HandHistoryUnitTest;
+using namespace std;
+
+/**
+ * @brief Fresh temporary path.
+ *
+ * @param name
+ * @return string
+ */
+string Test::tempPath(const string &name)
+{
+   auto path = filesystem::temp_directory_path() / name;
+   filesystem::remove(path);
+   return path.string();
+}
+
+/**
+ * @brief Read a whole history.
+ *
+ * @param path
+ * @param complete
+ * @return vector<HandHistory::Event>
+ */
+vector<HandHistory::Event> Test::readAll(const string &path, bool &complete)
+{
+   HistoryReader reader(path);
+   vector<HandHistory::Event> events;
+   HandHistory::Event event;
+   while (reader.next(event)) {
+      events.push_back(event);
+   }
+   complete = reader.isComplete();
+   return events;
+}
+
+/**
+ * @brief Test section for verifying the event encoding.
+ */
+TEST_CASE("Test History Round Trip")
+{
+   string path = Test::tempPath("history_round_trip.phh");
+   const CardId dealt[] = {0, 13, 26, 39, 51};
+   {
+      HistoryWriter writer(path, 64);
+      REQUIRE(writer.isOpen() == true);
+      writer.beginHand(7, 2, 10.5, 1);
+      writer.seat(1, 990.25);
+      writer.ante(1, 10.5);
+      writer.deal(1, dealt, 5);
+      writer.bet(1, HandHistory::RAISE, 42.0);
+      writer.discard(1, {0, 3});
+      writer.replace(1, dealt + 3, 2);
+      writer.win(1, 73.0, HandRank(6000));
+      writer.endHand();
+      REQUIRE(writer.getHands() == 1);
+   }
+
+   bool complete = false;
+   auto events = Test::readAll(path, complete);
+   REQUIRE(complete == true);
+   REQUIRE(events.size() == 9);
+   REQUIRE(events[0].type == HandHistory::HAND);
+   REQUIRE(events[0].seat == 2);
+   REQUIRE(events[0].hand == 7);
+   REQUIRE(events[0].amount == 10.5);
+   REQUIRE(events[0].dealer == 1);
+   REQUIRE(events[1].type == HandHistory::SEAT);
+   REQUIRE(events[1].amount == 990.25);
+   REQUIRE(events[3].type == HandHistory::DEAL);
+   REQUIRE(events[3].count == 5);
+   REQUIRE(events[3].values[4] == 51);
+   REQUIRE(events[4].action == HandHistory::RAISE);
+   REQUIRE(events[4].amount == 42.0);
+   REQUIRE(events[5].type == HandHistory::DISCARD);
+   REQUIRE(events[5].values[1] == 3);
+   REQUIRE(events[6].values[0] == 39);
+   REQUIRE(events[7].type == HandHistory::WIN);
+   REQUIRE(events[7].amount == 73.0);
+   REQUIRE(events[7].rank == HandRank(6000));
+   REQUIRE(events[8].type == HandHistory::END);
+
+   /**
+    * @brief Events gather back into whole hands.
+    */
+   SECTION("Whole Hands")
+   {
+      HistoryReader reader(path);
+      HandHistory::Hand hand;
+      REQUIRE(reader.next(hand) == true);
+      REQUIRE(hand.number == 7);
+      REQUIRE(hand.ante == 10.5);
+      REQUIRE(hand.dealer == 1);
+      REQUIRE(hand.seats.size() == 2);
+      REQUIRE(hand.seats[1].balance == 990.25);
+      REQUIRE(hand.seats[1].bets.size() == 1);
+      REQUIRE(hand.seats[1].bets[0].action == HandHistory::RAISE);
+      REQUIRE(hand.seats[1].discards == vector<int>{0, 3});
+      REQUIRE(hand.seats[1].won == 73.0);
+      REQUIRE(hand.seats[1].rank.getValue() == 6000);
+      REQUIRE(hand.seats[0].rank.isValid() == false);
+      REQUIRE(hand.cards == vector<CardId>{0, 13, 26, 39, 51, 39, 51});
+      REQUIRE(reader.next(hand) == false);
+      REQUIRE(reader.isComplete() == true);
+   }
+
+   /**
+    * @brief Reopening a history appends after its last hand.
+    */
+   SECTION("Append")
+   {
+      {
+         HistoryWriter writer(path);
+         writer.beginHand(8, 2, 10.5, 0);
+         writer.endHand();
+      }
+      events = Test::readAll(path, complete);
+      REQUIRE(complete == true);
+      REQUIRE(events.size() == 11);
+      REQUIRE(events[9].hand == 8);
+   }
+
+   /**
+    * @brief A hand cut short reads as incomplete.
+    */
+   SECTION("Truncated")
+   {
+      auto size = filesystem::file_size(path);
+      filesystem::resize_file(path, size - 3);
+      events = Test::readAll(path, complete);
+      REQUIRE(complete == false);
+      REQUIRE(events.size() == 7);
+   }
+
+   /**
+    * @brief Other files are neither read nor appended to.
+    */
+   SECTION("Foreign File")
+   {
+      string other = Test::tempPath("history_foreign.phh");
+      ofstream(other) << "not a history";
+      REQUIRE(HistoryReader(other).isOpen() == false);
+      REQUIRE(HistoryWriter(other).isOpen() == false);
+      filesystem::remove(other);
+   }
+   filesystem::remove(path);
+}
+
+/**
+ * @brief Test section for verifying hands recorded by the engine.
+ */
+TEST_CASE("Test Recorded Games")
+{
+   string path = Test::tempPath("history_games.phh");
+   auto recorder = make_shared<HistoryWriter>(path);
+   auto engine = make_shared<PokerEngine>();
+   engine->setHeadless(true);
+   engine->setRecorder(recorder);
+   for (int id = 1; id <= 4; ++id) {
+      engine->addPlayer(make_shared<AIPokerPlayer>(engine, id, 1e6));
+   }
+   for (int game = 0; game < 25; ++game) {
+      engine->reset();
+      engine->startGame();
+   }
+   engine->clearPlayers();
+   REQUIRE(recorder->getHands() == 25);
+   recorder->flush();
+
+   bool complete = false;
+   auto events = Test::readAll(path, complete);
+   REQUIRE(complete == true);
+   uint64_t hands = 0;
+   int wins = 0;
+   CardMask seen = 0;
+   for (auto &event : events) {
+      switch (event.type) {
+         case HandHistory::HAND:
+            REQUIRE(event.hand == ++hands);
+            REQUIRE(event.seat == 4);
+            seen = 0;
+            break;
+         case HandHistory::DEAL:
+            REQUIRE(event.count == 5);
+            [[fallthrough]];
+         case HandHistory::REPLACE:
+            for (int i = 0; i < event.count; ++i) {
+               REQUIRE(CardBits::contains(seen, event.values[i]) == false);
+               seen |= CardBits::toMask(event.values[i]);
+            }
+            break;
+         case HandHistory::BET:
+            REQUIRE(event.seat < 4);
+            REQUIRE(event.amount >= 0);
+            break;
+         case HandHistory::WIN:
+            REQUIRE(event.rank.isValid());
+            wins++;
+            break;
+         default:
+            break;
+      }
+   }
+   REQUIRE(hands == 25);
+   REQUIRE(wins >= 1);
+   filesystem::remove(path);
+}
+
+/**
+ * @brief Test section for verifying hands abandoned before they end.
+ */
+TEST_CASE("Test Abandoned Hands")
+{
+   string path = Test::tempPath("history_abandoned.phh");
+   auto recorder = make_shared<HistoryWriter>(path);
+   auto engine = make_shared<PokerEngine>();
+   engine->setHeadless(true);
+   engine->setRecorder(recorder);
+   for (int id = 1; id <= 3; ++id) {
+      engine->addPlayer(make_shared<AIPokerPlayer>(engine, id, 1e6));
+   }
+   engine->reset();
+   REQUIRE(engine->step().phase == PokerEngine::BETTING);
+   engine->reset();
+   for (int game = 0; game < 5; ++game) {
+      engine->reset();
+      engine->startGame();
+   }
+   REQUIRE(recorder->getHands() == 5);
+   recorder.reset();
+   engine->setRecorder(nullptr);
+   engine->clearPlayers();
+
+   HistoryReader reader(path);
+   HandHistory::Hand hand;
+   uint64_t hands = 0;
+   while (reader.next(hand)) {
+      REQUIRE(hand.number == hands + 2); ///< Numbered after the first
+      hands++;
+   }
+   REQUIRE(reader.isComplete() == true);
+   REQUIRE(hands == 5);
+
+   /**
+    * @brief A hand another hand starts before its end is skipped, and
+    * flushing or rotating never writes an open hand.
+    */
+   SECTION("Writer")
+   {
+      string other = Test::tempPath("history_abandoned_other.phh");
+      {
+         HistoryWriter writer(path);
+         writer.beginHand(10, 2, 1.0, 0);
+         writer.flush();
+         writer.beginHand(11, 2, 1.0, 0);
+         writer.seat(1, 50.0);
+         writer.rotate(other);
+         writer.endHand();
+         writer.beginHand(12, 2, 1.0, 0);
+         writer.abortHand();
+         writer.beginHand(13, 2, 1.0, 0); ///< Left open as the writer closes
+      }
+      HistoryReader again(path);
+      hands = 0;
+      while (again.next(hand)) {
+         hands++;
+      }
+      REQUIRE(again.isComplete() == true);
+      REQUIRE(hands == 5);
+      HistoryReader rotated(other);
+      REQUIRE(rotated.next(hand) == true);
+      REQUIRE(hand.number == 11);
+      REQUIRE(hand.seats[1].balance == 50.0);
+      REQUIRE(rotated.next(hand) == false);
+      REQUIRE(rotated.isComplete() == true);
+      filesystem::remove(other);
+   }
+
+   /**
+    * @brief A hand left open by an older writer is skipped on reading.
+    */
+   SECTION("Reader")
+   {
+      ifstream in(path, ios::binary);
+      string bytes(istreambuf_iterator<char>(in), {});
+      in.close();
+      string header = bytes.substr(0, HandHistory::HEADER_SIZE);
+      string body = bytes.substr(HandHistory::HEADER_SIZE);
+      ///< The last hand of the first copy loses its END event
+      ofstream(path, ios::binary | ios::trunc)
+          << header << body.substr(0, body.size() - 2) << body;
+      HistoryReader again(path);
+      hands = 0;
+      while (again.next(hand)) {
+         hands++;
+      }
+      REQUIRE(again.isComplete() == true);
+      REQUIRE(hands == 9);
+   }
+   filesystem::remove(path);
+}
+
+/**
+ * @brief Test section for verifying replayed games.
+ */
+TEST_CASE("Test Replayed Games")
+{
+   string path = Test::tempPath("history_replay.phh");
+   string again = Test::tempPath("history_replay_again.phh");
+   {
+      auto recorder = make_shared<HistoryWriter>(path);
+      auto engine = make_shared<PokerEngine>();
+      engine->setHeadless(true);
+      engine->setRecorder(recorder);
+      ///< Seven players draw enough cards to recycle the discards
+      for (int id = 1; id <= 7; ++id) {
+         engine->addPlayer(make_shared<AIPokerPlayer>(engine, id, 1e6));
+      }
+      ///< A session passes the deal round the table until players go
+      ///< broke, and the broke fold the rest of the hands
+      int played = engine->playSession(50).get();
+      REQUIRE(played >= 1);
+      for (int game = played; game < 50; ++game) {
+         engine->setDealer(game);
+         engine->reset();
+         engine->startGame();
+      }
+      engine->clearPlayers();
+   }
+
+   auto recorder = make_shared<HistoryWriter>(again);
+   auto results = Replay::run(path, recorder);
+   recorder->flush();
+   REQUIRE(results.complete == true);
+   REQUIRE(results.hands == 50);
+   REQUIRE(results.mismatches == 0);
+
+   ///< Played again, the hands record byte for byte the same
+   ifstream first(path, ios::binary), second(again, ios::binary);
+   string original(istreambuf_iterator<char>(first), {});
+   string replayed(istreambuf_iterator<char>(second), {});
+   REQUIRE(replayed.size() == original.size());
+   REQUIRE(replayed == original);
+
+   /**
+    * @brief A hand that did not pay its recorded winner is reported.
+    */
+   SECTION("Mismatch")
+   {
+      string wrong = Test::tempPath("history_replay_wrong.phh");
+      const CardId royal[] = {47, 48, 49, 50, 51};
+      const CardId junk[] = {0, 14, 28, 42, 19};
+      {
+         HistoryWriter writer(wrong);
+         writer.beginHand(1, 2, 10.0, 1);
+         for (int seat = 0; seat < 2; ++seat) {
+            writer.seat(seat, 1000.0);
+            writer.ante(seat, 10.0);
+         }
+         writer.deal(0, royal, 5);
+         writer.deal(1, junk, 5);
+         for (int seat = 0; seat < 2; ++seat) {
+            writer.bet(seat, HandHistory::CALL, 20.0);
+            writer.discard(seat, {});
+            writer.bet(seat, HandHistory::CALL, 20.0);
+         }
+         writer.win(1, 100.0);
+         writer.endHand();
+      }
+      results = Replay::run(wrong);
+      REQUIRE(results.hands == 1);
+      REQUIRE(results.mismatches == 1);
+      REQUIRE(results.firstMismatch == 0);
+      filesystem::remove(wrong);
+   }
+   filesystem::remove(path);
+   filesystem::remove(again);
+}
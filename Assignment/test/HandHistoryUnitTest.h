@@ -0,0 +1,39 @@
+/**
+ * @file test/HandHistoryUnitTest.h
+ * @brief Tester class for the binary hand-history recorder.
+ */
+
+#ifndef HANDHISTORYUNITTEST_H
+#define HANDHISTORYUNITTEST_H
+
+#include "../src/game/history/HandHistory.h"
+#include <string>
+#include <vector>
+
+/**
+ * @class HandHistoryUnitTest
+ * @brief Tester class for the binary hand-history recorder.
+ */
+class HandHistoryUnitTest
+{
+ public:
+   /**
+    * @brief Returns a fresh path in the temporary directory.
+    *
+    * @param name The file name.
+    * @return std::string The path, with any earlier file removed.
+    */
+   static std::string tempPath(const std::string &name);
+
+   /**
+    * @brief Reads every event of a history file.
+    *
+    * @param path The file.
+    * @param complete Set to whether the file ended after a whole hand.
+    * @return std::vector<HandHistory::Event> The events in file order.
+    */
+   static std::vector<HandHistory::Event>
+   readAll(const std::string &path, bool &complete);
+};
+
+#endif // HANDHISTORYUNITTEST_H
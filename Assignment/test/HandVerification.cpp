@@ -0,0 +1,177 @@
+/**
+ * @file test/HandVerification.cpp
+ * @brief Implementation of the HandVerification class and its entry point.
+ */
+#include "HandVerification.h"
+#include "../src/game/resources/Card.h"
+#include "../src/game/resources/CardBits.h"
+#include "../utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+using CardPtr = shared_ptr<Card>;
+
+const array<long, PokerHand::INVALID_HAND> HandVerification::frequency = {
+    1302540, 1098240, 123552, 54912, 10200, 5108, 3744, 624, 40
+};
+
+void HandVerification::Tally::merge(const Tally &other)
+{
+   for (int i = 0; i < PokerHand::INVALID_HAND; ++i) {
+      if (other.categories[i] == 0) {
+         continue;
+      }
+      lowest[i] = categories[i] ? min(lowest[i], other.lowest[i])
+                                : other.lowest[i];
+      highest[i] = max(highest[i], other.highest[i]);
+      categories[i] += other.categories[i];
+   }
+   scores.resize(max(scores.size(), other.scores.size()));
+   for (size_t i = 0; i < other.scores.size(); ++i) {
+      if (other.scores[i]) {
+         scores[i] = true;
+      }
+   }
+   hands += other.hands;
+   invalid += other.invalid;
+}
+
+void HandVerification::deal(int lowest, Tally &tally)
+{
+   const int n = CardBits::DECK_SIZE;
+   vector<CardPtr> cards(5);
+   cards[0] = Card::get(lowest);
+   for (int b = lowest + 1; b < n; ++b) {
+      cards[1] = Card::get(b);
+      for (int c = b + 1; c < n; ++c) {
+         cards[2] = Card::get(c);
+         for (int d = c + 1; d < n; ++d) {
+            cards[3] = Card::get(d);
+            for (int e = d + 1; e < n; ++e) {
+               cards[4] = Card::get(e);
+               vector<CardPtr> dealt = cards;
+               PokerHand hand(dealt);
+               ++tally.hands;
+               int category = hand.getCategory();
+               if (!hand.isValid() || category >= PokerHand::INVALID_HAND) {
+                  ++tally.invalid;
+                  continue;
+               }
+               long long score = hand.getScore();
+               if (tally.categories[category]++ == 0) {
+                  tally.lowest[category] = tally.highest[category] = score;
+               }
+               tally.lowest[category] = min(tally.lowest[category], score);
+               tally.highest[category] = max(tally.highest[category], score);
+               if (score >= 0 && size_t(score) >= tally.scores.size()) {
+                  tally.scores.resize(score + 1);
+               }
+               if (score >= 0) {
+                  tally.scores[score] = true;
+               }
+            }
+         }
+      }
+   }
+}
+
+HandVerification::Tally HandVerification::run(int threads)
+{
+   vector<Tally> tallies(threads);
+   atomic<int> next{0};
+   auto worker = [&next](Tally &tally) {
+      ///< Low cards lead the most hands, so workers claim them one at a time
+      for (int a; (a = next++) <= CardBits::DECK_SIZE - 5;) {
+         deal(a, tally);
+      }
+   };
+
+   auto start = chrono::steady_clock::now();
+   vector<thread> workers;
+   for (int i = 1; i < threads; ++i) {
+      workers.emplace_back(worker, ref(tallies[i]));
+   }
+   worker(tallies[0]);
+   for (auto &t : workers) {
+      t.join();
+   }
+   chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+   Tally total;
+   for (auto &tally : tallies) {
+      total.merge(tally);
+   }
+   total.seconds = elapsed.count();
+   return total;
+}
+
+bool HandVerification::check(const Tally &tally, vector<string> &errors)
+{
+   if (tally.hands != HAND_COUNT) {
+      errors.push_back("Dealt " + to_string(tally.hands) + " hands.");
+   }
+   if (tally.invalid != 0) {
+      errors.push_back(to_string(tally.invalid) + " hands were invalid.");
+   }
+   for (int i = 0; i < PokerHand::INVALID_HAND; ++i) {
+      if (tally.categories[i] != frequency[i]) {
+         errors.push_back(
+             PokerHand::HAND_NAMES.at(PokerHand::Category(i)) + ": " +
+             to_string(tally.categories[i]) + " hands, expected " +
+             to_string(frequency[i]) + "."
+         );
+      }
+      if (i > 0 && tally.lowest[i] <= tally.highest[i - 1]) {
+         errors.push_back(
+             PokerHand::HAND_NAMES.at(PokerHand::Category(i)) +
+             " scores overlap the category below."
+         );
+      }
+   }
+   long classes = count(tally.scores.begin(), tally.scores.end(), true);
+   if (classes != CLASS_COUNT) {
+      errors.push_back(
+          to_string(classes) + " distinct scores, expected " +
+          to_string(CLASS_COUNT) + "."
+      );
+   }
+   return errors.empty();
+}
+
+/**
+ * @brief Verifies every hand at 1, 2, 4, ... threads up to a maximum.
+ * @details The maximum is the first argument, or the hardware concurrency.
+ * @return Returns 0 if every run passed its checks.
+ */
+int main(int argc, char *argv[])
+{
+   int most = argc > 1 ? atoi(argv[1]) : thread::hardware_concurrency();
+   most = max(most, 1);
+
+   bool passed = true;
+   for (int threads = 1;; threads = min(threads * 2, most)) {
+      auto tally = HandVerification::run(threads);
+      vector<string> errors;
+      passed &= HandVerification::check(tally, errors);
+      for (auto &error : errors) {
+         Logger::error(error);
+      }
+
+      ostringstream ss;
+      ss << setw(3) << threads << " thread(s)" << fixed << setprecision(0)
+         << setw(14) << tally.hands / tally.seconds << " hands/s"
+         << setprecision(3) << setw(10) << tally.seconds << " s"
+         << (errors.empty() ? "  ok" : "  FAILED");
+      Logger::console(ss.str());
+      if (threads == most) {
+         break;
+      }
+   }
+   return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
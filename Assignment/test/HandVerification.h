@@ -0,0 +1,79 @@
+/**
+ * @file test/HandVerification.h
+ * @brief Exhaustive verification and throughput measurement of PokerHand.
+ */
+
+#ifndef HANDVERIFICATION_H
+#define HANDVERIFICATION_H
+
+#include "../src/game/resources/PokerHand.h"
+#include <array>
+#include <string>
+#include <vector>
+
+/**
+ * @class HandVerification
+ * @brief Evaluates every five card hand with PokerHand across threads.
+ * @details Each run deals all 2,598,960 hands, splitting them by their
+ * lowest card among worker threads, and checks the category histogram,
+ * the number of distinct scores and that scores never overlap between
+ * categories. It doubles as the throughput baseline for evaluator changes.
+ */
+class HandVerification
+{
+ public:
+   static constexpr long HAND_COUNT = 2598960; ///< 52 choose 5
+   static constexpr int CLASS_COUNT = 7462;    ///< Distinct hand values
+
+   ///< Number of five card hands in each category.
+   static const std::array<long, PokerHand::INVALID_HAND> frequency;
+
+   /**
+    * @brief Totals gathered while dealing every hand.
+    */
+   struct Tally
+   {
+      long hands = 0;   ///< Hands evaluated
+      long invalid = 0; ///< Hands PokerHand rejected
+      std::array<long, PokerHand::INVALID_HAND> categories{};
+      std::array<long long, PokerHand::INVALID_HAND> lowest{};
+      std::array<long long, PokerHand::INVALID_HAND> highest{};
+      std::vector<bool> scores; ///< Scores seen, indexed by score
+      double seconds = 0;       ///< Wall clock time of the run
+
+      /**
+       * @brief Folds the totals of another worker into this one.
+       *
+       * @param other The other worker's tally.
+       */
+      void merge(const Tally &other);
+   };
+
+   /**
+    * @brief Evaluates every five card hand.
+    *
+    * @param threads The number of worker threads.
+    * @return Tally The combined totals of all workers.
+    */
+   static Tally run(int threads);
+
+   /**
+    * @brief Checks a tally against the known hand counts.
+    *
+    * @param tally The totals of a run.
+    * @param errors Receives a description of each mismatch.
+    * @return true if every check passed.
+    */
+   static bool check(const Tally &tally, std::vector<std::string> &errors);
+
+ private:
+   /**
+    * @brief Evaluates every hand whose lowest card is the given id.
+    *
+    * @param lowest The lowest card id of each hand.
+    * @param tally Accumulates the results.
+    */
+   static void deal(int lowest, Tally &tally);
+};
+
+#endif // HANDVERIFICATION_H
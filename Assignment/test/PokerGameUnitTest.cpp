@@ -4,10 +4,15 @@
  */
 #include "./PokerGameUnitTest.h"
 #include "../../catch_amalgamated.hpp"
+#include "../src/game/PokerEngine.h"
+#include "../src/game/player/AIPokerPlayer.h"
+#include "../src/game/player/HumanPokerPlayer.h"
 #include "../src/game/resources/Hand.h"
 #include "../src/game/resources/PokerHand.h"
 #include "../utils/Logger.h"
 #include <iostream>
+#include <random>
+#include <sstream>
 
 using HandPtr = std::shared_ptr<Hand>;
 using Test = PokerGameUnitTest;
@@ -283,4 +288,296 @@ TEST_CASE("Test Straight Flush Comparisons")
          REQUIRE(result == expected);
       }
    }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Test section for verifying unattended games.
+ */
+TEST_CASE("Test Headless Engine")
+{
+   auto engine = make_shared<PokerEngine>();
+   ostringstream output;
+   engine->setHeadless(true, &output);
+   REQUIRE(engine->isHeadless() == true);
+
+   engine->addPlayer(make_shared<HumanPokerPlayer>(engine, 1, 100.0));
+   for (int id = 2; id <= 5; ++id) {
+      engine->addPlayer(make_shared<AIPokerPlayer>(engine, id, 1e6));
+   }
+
+   for (int game = 0; game < 50; ++game) {
+      engine->reset();
+      REQUIRE(engine->getPot() == 0);
+      engine->startGame();
+      auto outcomes = engine->endGame(game == 0);
+      REQUIRE(outcomes.size() == 4); ///< The human player was not seated
+      CardMask dealt = 0;
+      for (auto &[score, outcome] : outcomes) {
+         if (game > 0 && outcome.playerHand->isEmpty()) {
+            continue; ///< Out of money for the ante, so never dealt in
+         }
+         REQUIRE(outcome.playerHand->isValid() == true);
+         REQUIRE(score == outcome.playerHand->getScore());
+         REQUIRE((dealt & outcome.playerHand->getMask()) == 0);
+         dealt |= outcome.playerHand->getMask();
+      }
+   }
+   REQUIRE(output.str().find("Showdown:") != string::npos);
+}
+
+/**
+ * @brief Test section for verifying tables waiting on remote players.
+ */
+TEST_CASE("Test Remote Decisions")
+{
+   Logger::Redirect quiet(nullptr);
+   ///< Call, stand pat, then call or go all in
+   const vector<string> answers = {"C", "n", "C"};
+   vector<shared_ptr<PokerEngine>> engines;
+   vector<shared_ptr<HumanPokerPlayer>> humans;
+   for (int table = 0; table < 100; ++table) {
+      auto engine = make_shared<PokerEngine>();
+      engine->setHeadless(true);
+      auto human = make_shared<HumanPokerPlayer>(engine, 1, 1000.0);
+      human->setRemote(true);
+      REQUIRE(human->readsConsole() == false);
+      engine->addPlayer(human);
+      for (int id = 2; id <= 4; ++id) {
+         engine->addPlayer(make_shared<AIPokerPlayer>(engine, id, 1e6));
+      }
+      engine->reset();
+      engine->startGame();
+      REQUIRE(engine->isPlaying() == true);
+      REQUIRE(human->isWaiting() == true);
+      engines.push_back(engine);
+      humans.push_back(human);
+   }
+
+   ///< One thread answers every table in turn until every hand is over
+   for (const auto &answer : answers) {
+      for (size_t table = 0; table < engines.size(); ++table) {
+         REQUIRE(humans[table]->isWaiting() == true);
+         humans[table]->answer(answer);
+      }
+   }
+   for (size_t table = 0; table < engines.size(); ++table) {
+      REQUIRE(engines[table]->isPlaying() == false);
+      REQUIRE(humans[table]->isWaiting() == false);
+      REQUIRE(engines[table]->endGame(false).size() == 4);
+      REQUIRE(engines[table]->determineWinners().empty() == false);
+   }
+
+   /**
+    * @brief A hand abandoned while waiting forgets its question.
+    */
+   SECTION("Abandoned")
+   {
+      auto engine = make_shared<PokerEngine>();
+      engine->setHeadless(true);
+      auto human = make_shared<HumanPokerPlayer>(engine, 1, 1000.0);
+      human->setRemote(true);
+      engine->addPlayer(human);
+      engine->addPlayer(make_shared<AIPokerPlayer>(engine, 2, 1e6));
+      engine->startGame();
+      REQUIRE(human->isWaiting() == true);
+      engine->reset();
+      REQUIRE(engine->isPlaying() == false);
+      REQUIRE(human->isWaiting() == false);
+      REQUIRE_THROWS_AS(human->bet(), logic_error);
+      engine->clearPlayers();
+   }
+   for (auto &engine : engines) {
+      engine->clearPlayers();
+   }
+}
+
+/**
+ * @brief Test section for verifying tables stepped one action at a time.
+ */
+TEST_CASE("Test Stepped Tables")
+{
+   using Engine = PokerEngine;
+   mt19937 rng(11);
+   vector<shared_ptr<Engine>> engines;
+   vector<Engine::Turn> turns;
+   for (int table = 0; table < 50; ++table) {
+      auto engine = make_shared<Engine>();
+      engine->setHeadless(true);
+      for (int id = 1; id <= 4; ++id) {
+         engine->addPlayer(make_shared<AIPokerPlayer>(engine, id, 1000.0));
+      }
+      engine->reset();
+      REQUIRE(engine->getPhase() == Engine::ANTE);
+      turns.push_back(engine->step());
+      REQUIRE(engine->getPhase() == Engine::BETTING);
+      engines.push_back(engine);
+   }
+
+   ///< One thread takes one action at each table in turn
+   for (bool acting = true; acting;) {
+      acting = false;
+      for (size_t table = 0; table < engines.size(); ++table) {
+         auto &engine = engines[table];
+         auto &turn = turns[table];
+         if (turn.phase == Engine::OVER) {
+            continue;
+         }
+         acting = true;
+         REQUIRE(engine->getPhase() == turn.phase);
+         REQUIRE(engine->step().seat == turn.seat);
+
+         Engine::Action action;
+         if (turn.phase == Engine::DRAWING) {
+            REQUIRE(turn.legal == 1u << Engine::DRAW);
+            REQUIRE(turn.cards == 5);
+            REQUIRE_THROWS_AS(
+                engine->step({Engine::DRAW, 0, {1, 1}}), invalid_argument
+            );
+            REQUIRE_THROWS_AS(
+                engine->step({Engine::DRAW, 0, {5}}), invalid_argument
+            );
+            action.move = Engine::DRAW;
+            action.discards = {0, 4};
+         } else {
+            REQUIRE(turn.phase == Engine::BETTING);
+            REQUIRE(turn.allows(Engine::FOLD));
+            REQUIRE_THROWS_AS(
+                engine->step({Engine::DRAW, 0, {}}), invalid_argument
+            );
+            if (turn.allows(Engine::RAISE)) {
+               REQUIRE_THROWS_AS(
+                   engine->step({Engine::RAISE, turn.call, {}}),
+                   invalid_argument
+               );
+            }
+            vector<Engine::Move> legal;
+            for (auto move : {Engine::FOLD, Engine::CALL, Engine::RAISE}) {
+               if (turn.allows(move)) {
+                  legal.push_back(move);
+               }
+            }
+            action.move = legal[rng() % legal.size()];
+            action.amount = turn.call + 5;
+         }
+         double pot = engine->getPot();
+         double call = turn.call;
+         turn = engine->step(action);
+         if (action.move == Engine::CALL) {
+            pot += call;
+         } else if (action.move == Engine::RAISE) {
+            pot += action.amount;
+         }
+         REQUIRE(engine->getPot() == pot);
+      }
+   }
+   for (auto &engine : engines) {
+      REQUIRE(engine->getPhase() == Engine::OVER);
+      REQUIRE(engine->step().phase == Engine::OVER);
+      REQUIRE_THROWS_AS(engine->step(Engine::Action{}), invalid_argument);
+      engine->clearPlayers();
+   }
+}
+
+/**
+ * @brief Test section for verifying sessions of hands at one table.
+ */
+TEST_CASE("Test Sessions")
+{
+   auto engine = make_shared<PokerEngine>();
+   engine->setHeadless(true);
+   vector<shared_ptr<AIPokerPlayer>> players;
+   for (int id = 1; id <= 4; ++id) {
+      players.push_back(make_shared<AIPokerPlayer>(engine, id, 1000.0));
+      engine->addPlayer(players.back());
+   }
+   REQUIRE(engine->getDealer() == 3);
+
+   ///< The seat after the dealer is dealt to and acts first
+   engine->setDealer(1);
+   engine->reset();
+   auto turn = engine->step();
+   REQUIRE(turn.seat == 2);
+   engine->step({PokerEngine::FOLD});
+   REQUIRE(engine->step().seat == 3);
+
+   ///< Hands are emptied in place unless an Outcome still shows them
+   const PokerHand *reused = players[0]->show().playerHand.get();
+   auto shown = players[1]->show();
+   engine->reset();
+   REQUIRE(players[0]->show().playerHand.get() == reused);
+   REQUIRE(players[0]->show().playerHand->isEmpty());
+   REQUIRE(players[1]->show().playerHand != shown.playerHand);
+   REQUIRE(shown.playerHand->size() == 5);
+
+   ///< The abandoned hand keeps its antes; the session loses no chips, down
+   ///< to the rounding of split pots
+   double before = 0;
+   for (auto &player : players) {
+      before += player->getBalance();
+   }
+   int played = engine->playSession(40).get();
+   REQUIRE(played >= 1);
+   REQUIRE(played <= 40);
+   REQUIRE(engine->getDealer() == (1 + played) % 4);
+   REQUIRE(engine->getPhase() == PokerEngine::OVER);
+   double total = 0;
+   for (auto &player : players) {
+      REQUIRE(player->getBalance() >= 0);
+      total += player->getBalance();
+   }
+   REQUIRE(total == Approx(before).epsilon(0).margin(1e-6)); ///< Rounding
+
+   /**
+    * @brief A session ends once fewer than two players can pay the ante.
+    */
+   SECTION("Broke")
+   {
+      engine->setAnte(5000.0);
+      REQUIRE(engine->playSession(10).get() == 0);
+   }
+   engine->clearPlayers();
+   REQUIRE(engine->getDealer() == -1);
+}
+
+/**
+ * @brief Test section for verifying AI bets follow continuous strength.
+ */
+TEST_CASE("Test Bet Sizing")
+{
+   using Strategy = AIPokerPlayer::Strategy;
+   auto engine = make_shared<PokerEngine>();
+   ostringstream output;
+   engine->setHeadless(true, &output);
+
+   ///< Deals a hand to a new player and returns its bet
+   auto bet = [&engine](string notation) {
+      auto player = make_shared<AIPokerPlayer>(
+          engine, engine->getContenders() + 1, 1000.0, Strategy::CONSERVATIVE
+      );
+      engine->addPlayer(player);
+      player->seed(7);
+      PokerHand hand(notation);
+      CardCollection dealt;
+      for (int i = 0; i < static_cast<int>(hand.size()); ++i) {
+         dealt.add(hand.get(i));
+      }
+      player->receive(dealt);
+      return player->bet();
+   };
+
+   double deuces = bet("2D 2H 3S 4C 5H");
+   double aces = bet("AD AH KS QC JH");
+   REQUIRE(engine->getContenders() == 2);
+   REQUIRE(aces > deuces);
+   REQUIRE(aces <= 1000.0);
+
+   ///< Against more players, the same pair of aces bets less
+   for (int i = 0; i < 4; ++i) {
+      engine->addPlayer(make_shared<AIPokerPlayer>(engine, 10 + i, 1000.0));
+   }
+   double crowded = bet("AS AC KD QH JD");
+   REQUIRE(engine->getContenders() == 7);
+   REQUIRE(crowded < aces);
+   REQUIRE(crowded > deuces);
+   engine->clearPlayers();
+}
@@ -4,10 +4,16 @@
  */
 #include "./PokerHandUnitTest.h"
 #include "../../catch_amalgamated.hpp"
+#include "../src/game/resources/Card.h"
 #include "../src/game/resources/Hand.h"
+#include "../src/game/resources/HandNotation.h"
+#include "../src/game/resources/HandEvaluator.h"
 #include "../src/game/resources/PokerHand.h"
+#include "../src/game/resources/SuitIsomorphism.h"
 #include "../utils/Logger.h"
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 using HandPtr = std::shared_ptr<Hand>;
 using Test = PokerHandUnitTest;
@@ -913,3 +919,259 @@ TEST_CASE("Test Error Cases")
       REQUIRE(hand->isValid() == false);
    }
 }
+
+/**
+ * @brief Test section for verifying the hand notation scanner.
+ */
+TEST_CASE("Test Hand Notation")
+{
+   CardId ids[HandNotation::MAX_CARDS];
+
+   /**
+    * @brief Spaced, comma separated and compact forms scan alike.
+    */
+   SECTION("Notation Forms")
+   {
+      const vector<string> forms = {
+          "AS KS QS JS TS", "As,Ks,Qs,Js,Ts", "AsKsQsJsTs", " as, ks qsJS\tts "
+      };
+      for (const string &notation : forms) {
+         auto result = HandNotation::scan(notation, ids);
+         REQUIRE(result.status == HandNotation::OK);
+         REQUIRE(result.count == 5);
+         REQUIRE(ids[0] == CardBits::toId('A', 'S'));
+         REQUIRE(ids[4] == CardBits::toId('T', 'S'));
+      }
+      REQUIRE(HandNotation::scan("", ids).count == 0);
+      REQUIRE(HandNotation::scan("2C 3C 4C 5C 6C 7C 8C", ids).count == 7);
+   }
+
+   /**
+    * @brief Errors report their kind and position.
+    */
+   SECTION("Notation Errors")
+   {
+      auto result = HandNotation::scan("2D 2d AS 7C KD", ids);
+      REQUIRE(result.status == HandNotation::DUPLICATE_CARD);
+      REQUIRE(result.position == 3);
+      REQUIRE(result.count == 1);
+
+      result = HandNotation::scan("3F TS AC QD 4H", ids);
+      REQUIRE(result.status == HandNotation::INVALID_CARD);
+      REQUIRE(result.position == 0);
+
+      result = HandNotation::scan("AsKsQ", ids);
+      REQUIRE(result.status == HandNotation::INVALID_CARD);
+      REQUIRE(result.position == 4);
+
+      result = HandNotation::scan("2C 3C 4C 5C 6C 7C 8C 9C", ids);
+      REQUIRE(result.status == HandNotation::TOO_MANY_CARDS);
+      REQUIRE(result.count == HandNotation::MAX_CARDS);
+   }
+
+   /**
+    * @brief PokerHand accepts every form and rejects duplicates.
+    */
+   SECTION("Poker Hand Notation")
+   {
+      PokerHand spaced(input[Category::FLUSH][Sample::EXAMPLE_1]);
+      PokerHand compact("2d4d7d9dJd");
+      REQUIRE(compact.isValid() == true);
+      REQUIRE(compact.getScore() == spaced.getScore());
+      REQUIRE(PokerHand("2D,2D,AS,7C,KD").isValid() == false);
+   }
+}
+
+/**
+ * @brief Test section for verifying incremental hand updates.
+ */
+TEST_CASE("Test Incremental Updates")
+{
+   /**
+    * @brief A hand dealt card by card matches one built at once.
+    */
+   SECTION("Card By Card")
+   {
+      auto built = make_shared<PokerHand>("KH 9S KD 2C 9H");
+      auto dealt = make_shared<PokerHand>();
+      for (string token : {"KH", "9S", "KD", "2C"}) {
+         *dealt += Card::get(CardBits::toId(token[0], token[1]));
+         REQUIRE(dealt->isValid() == false);
+         REQUIRE(dealt->getCategory() == Category::INVALID_HAND);
+      }
+      *dealt += Card::get(CardBits::toId('9', 'H'));
+      REQUIRE(dealt->isValid() == true);
+      REQUIRE(dealt->getScore() == built->getScore());
+      REQUIRE(dealt->getMask() == built->getMask());
+      REQUIRE(dealt->getCardNames(false) == built->getCardNames(false));
+      REQUIRE(dealt->getRankCount(CardBits::toRank('K')) == 2);
+      REQUIRE(dealt->getSuitCount(CardBits::toSuit('H')) == 2);
+      REQUIRE(
+          dealt->indexByCategory(Category::TWO_PAIR) ==
+          built->indexByCategory(Category::TWO_PAIR)
+      );
+   }
+
+   /**
+    * @brief Replacing cards updates counts, mask and score.
+    */
+   SECTION("Replace Cards")
+   {
+      auto hand = make_shared<PokerHand>("KH 9S KD 2C 9H");
+      auto nine = Card::get(CardBits::toId('9', 'S'));
+      *hand -= nine;
+      REQUIRE(hand->isValid() == false);
+      REQUIRE(hand->getRankCount(CardBits::toRank('9')) == 1);
+      *hand += Card::get(CardBits::toId('K', 'S'));
+      REQUIRE(hand->getCategory() == Category::THREE_OF_A_KIND);
+      REQUIRE(hand->getScore() == PokerHand("KH KS KD 2C 9H").getScore());
+
+      *hand -= Card::get(CardBits::toId('2', 'C'));
+      *hand += Card::get(CardBits::toId('K', 'D'));
+      REQUIRE(hand->isValid() == false); ///< Repeated king of diamonds
+      *hand -= Card::get(CardBits::toId('K', 'D'));
+      REQUIRE(hand->size() == 3);
+      REQUIRE(hand->getRankCount(CardBits::toRank('K')) == 2);
+      CardMask left = CardBits::toMask(CardBits::toId('K', 'H')) |
+                      CardBits::toMask(CardBits::toId('K', 'S')) |
+                      CardBits::toMask(CardBits::toId('9', 'H'));
+      REQUIRE(hand->getMask() == left);
+   }
+}
+
+/**
+ * @brief Test section for verifying suit isomorphism classes.
+ */
+TEST_CASE("Test Suit Isomorphism")
+{
+   /**
+    * @brief Every hand falls into one class, of the size the class reports,
+    * and keeps its rank and its way back from the canonical form.
+    */
+   SECTION("Every Hand")
+   {
+      vector<int> counts(SuitIsomorphism::CLASS_COUNT, 0);
+      long hands = 0, mismatches = 0;
+      const CardMask end = CardMask{1} << CardBits::DECK_SIZE;
+      for (CardMask hand = 0x1F; hand < end; ++hands) {
+         auto canonical = SuitIsomorphism::canonicalize(hand);
+         uint32_t index = SuitIsomorphism::index(hand);
+         if (index >= SuitIsomorphism::CLASS_COUNT ||
+             SuitIsomorphism::unindex(index) != canonical.hand ||
+             SuitIsomorphism::restore(canonical.hand, canonical) != hand ||
+             HandEvaluator::evaluate(canonical.hand) !=
+                 HandEvaluator::evaluate(hand)) {
+            ++mismatches;
+         } else {
+            ++counts[index];
+         }
+         hand = CardBits::nextCombination(hand);
+      }
+      REQUIRE(hands == 2598960);
+      REQUIRE(mismatches == 0);
+      for (uint32_t index = 0; index < SuitIsomorphism::CLASS_COUNT;
+           ++index) {
+         if (counts[index] != SuitIsomorphism::size(index)) {
+            ++mismatches;
+         }
+      }
+      REQUIRE(mismatches == 0);
+      REQUIRE(SuitIsomorphism::unindex(SuitIsomorphism::CLASS_COUNT) == 0);
+      REQUIRE(SuitIsomorphism::size(SuitIsomorphism::CLASS_COUNT) == 0);
+   }
+
+   /**
+    * @brief Hands share a class exactly when they differ only by suits.
+    */
+   SECTION("Poker Hands")
+   {
+      PokerHand hand("AH KH QH JH 2C");
+      auto suitClass = [](string notation) {
+         return PokerHand(notation).getSuitClass();
+      };
+      REQUIRE(hand.getSuitClass() == suitClass("AS KS QS JS 2D"));
+      REQUIRE(hand.getSuitClass() != suitClass("AS KS QS JS 2S"));
+      REQUIRE(hand.getSuitClass() != suitClass("AS KS QS JC 2D"));
+      REQUIRE(
+          SuitIsomorphism::unindex(hand.getSuitClass()) ==
+          hand.canonicalize().hand
+      );
+      REQUIRE(SuitIsomorphism::isCanonical(hand.canonicalize().hand));
+      REQUIRE(
+          PokerHand("7H 7D KC 4S").getSuitClass() ==
+          SuitIsomorphism::INVALID_CLASS
+      );
+      REQUIRE(SuitIsomorphism::index(0) == SuitIsomorphism::INVALID_CLASS);
+   }
+
+   /**
+    * @brief Dead cards split suits that the hand alone cannot tell apart.
+    */
+   SECTION("Dead Cards")
+   {
+      PokerHand hand("AC AD 7H 5S 2S");
+      auto ace = [](char suit) {
+         return CardBits::toMask(CardBits::toId('A', suit));
+      };
+      auto clubs = hand.canonicalize(ace('C') | ace('H'));
+      auto diamonds = hand.canonicalize(ace('D') | ace('H'));
+      auto spades = hand.canonicalize(ace('S') | ace('H'));
+      REQUIRE(clubs.hand == diamonds.hand);
+      REQUIRE(clubs.dead == diamonds.dead);
+      REQUIRE(clubs.dead != spades.dead);
+      REQUIRE(SuitIsomorphism::isCanonical(clubs.hand, clubs.dead));
+      REQUIRE(
+          SuitIsomorphism::restore(clubs.dead, clubs) == (ace('C') | ace('H'))
+      );
+      REQUIRE(
+          SuitIsomorphism::restore(diamonds.hand, diamonds) == hand.getMask()
+      );
+   }
+}
+
+/**
+ * @brief Test section for verifying compact hand ranks.
+ */
+TEST_CASE("Test Hand Ranks")
+{
+   /**
+    * @brief Ranks order, compare and describe hands as scores do.
+    */
+   SECTION("Ordering")
+   {
+      PokerHand pair("2D 2H 3S 4C 5H"), flush("2D 3D 4D 5D 7D");
+      REQUIRE(pair.getRank().getValue() == pair.getScore());
+      REQUIRE(pair.getRank() < flush.getRank());
+      REQUIRE(flush.getRank() == PokerHand("2H 3H 4H 5H 7H").getRank());
+      REQUIRE(pair.getRank().getCategory() == Category::ONE_PAIR);
+      REQUIRE(flush.getRank().getDescription() == "Flush");
+
+      vector<HandRank> ranks;
+      for (const auto &row : Test::input) {
+         for (const auto &notation : row) {
+            ranks.push_back(PokerHand(notation).getRank());
+         }
+      }
+      sort(ranks.begin(), ranks.end());
+      for (size_t i = 1; i < ranks.size(); ++i) {
+         REQUIRE(ranks[i - 1].getValue() <= ranks[i].getValue());
+      }
+      REQUIRE(sizeof(HandRank) == 2);
+   }
+
+   /**
+    * @brief Invalid hands and out of range values rank below all others.
+    */
+   SECTION("Invalid Ranks")
+   {
+      PokerHand partial("2D 2H 3S 4C");
+      REQUIRE(partial.getRank() == HandRank());
+      REQUIRE(partial.getRank().isValid() == false);
+      REQUIRE(partial.getRank().getCategory() == Category::INVALID_HAND);
+      REQUIRE(HandRank(7463) == HandRank());
+      REQUIRE(HandRank() < HandRank(HandRank::WORST));
+      REQUIRE(
+          HandRank(HandRank::BEST).getCategory() == Category::STRAIGHT_FLUSH
+      );
+   }
+}
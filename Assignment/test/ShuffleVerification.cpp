@@ -0,0 +1,158 @@
+/**
+ * @file test/ShuffleVerification.cpp
+ * @brief Implementation of the ShuffleVerification class and its entry point.
+ */
+#include "ShuffleVerification.h"
+#include "../src/game/resources/Deck.h"
+#include "../utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+void ShuffleVerification::Tally::merge(const Tally &other)
+{
+   landed.resize(max(landed.size(), other.landed.size()));
+   for (size_t position = 0; position < other.landed.size(); ++position) {
+      for (int card = 0; card < CARDS; ++card) {
+         landed[position][card] += other.landed[position][card];
+      }
+   }
+   shuffles += other.shuffles;
+   count = max(count, other.count);
+}
+
+ShuffleVerification::Tally
+ShuffleVerification::run(int threads, long shuffles, int count, uint64_t seed)
+{
+   ///< Shuffling all but the bottom card fixes the bottom card too
+   count = count >= CARDS - 1 ? CARDS : max(count, 1);
+   vector<Tally> tallies(threads);
+   atomic<long> next{0};
+   auto worker = [&, count](int index) {
+      Tally &tally = tallies[index];
+      tally.count = count;
+      tally.landed.assign(count, {});
+      Deck deck;
+      deck.seed(seed + index);
+      for (long first; (first = next.fetch_add(BATCH)) < shuffles;) {
+         long last = min(first + BATCH, shuffles);
+         for (long i = first; i < last; ++i) {
+            deck.reset();
+            deck.shuffle(count);
+            for (int position = 0; position < count; ++position) {
+               tally.landed[position][deck.getId(CARDS - 1 - position)]++;
+            }
+         }
+         tally.shuffles += last - first;
+      }
+   };
+
+   auto start = chrono::steady_clock::now();
+   vector<thread> workers;
+   for (int i = 1; i < threads; ++i) {
+      workers.emplace_back(worker, i);
+   }
+   worker(0);
+   for (auto &t : workers) {
+      t.join();
+   }
+   chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+   Tally total;
+   for (auto &tally : tallies) {
+      total.merge(tally);
+   }
+   total.seconds = elapsed.count();
+   return total;
+}
+
+double ShuffleVerification::chiSquare(const Tally &tally)
+{
+   double expected = double(tally.shuffles) / CARDS;
+   double sum = 0;
+   for (auto &position : tally.landed) {
+      for (long seen : position) {
+         sum += (seen - expected) * (seen - expected) / expected;
+      }
+   }
+   return sum;
+}
+
+int ShuffleVerification::freedom(const Tally &tally)
+{
+   int positions = static_cast<int>(tally.landed.size());
+   return positions == CARDS ? (CARDS - 1) * (CARDS - 1)
+                             : positions * (CARDS - 1);
+}
+
+bool ShuffleVerification::check(const Tally &tally, vector<string> &errors)
+{
+   for (size_t position = 0; position < tally.landed.size(); ++position) {
+      long sum = 0;
+      for (long seen : tally.landed[position]) {
+         sum += seen;
+      }
+      if (sum != tally.shuffles) {
+         errors.push_back(
+             "Position " + to_string(position) + " holds " + to_string(sum) +
+             " cards over " + to_string(tally.shuffles) + " shuffles."
+         );
+      }
+   }
+   double statistic = chiSquare(tally);
+   double mean = freedom(tally);
+   double limit = 5 * sqrt(2 * mean); ///< Five standard deviations
+   if (abs(statistic - mean) > limit) {
+      ostringstream ss;
+      ss << "Chi-square " << fixed << setprecision(1) << statistic << " with "
+         << freedom(tally) << " degrees of freedom is not uniform.";
+      errors.push_back(ss.str());
+   }
+   return errors.empty();
+}
+
+/**
+ * @brief Tests full and five card shuffles at 1, 2, 4, ... threads.
+ * @details The maximum thread count is the first argument, or the hardware
+ * concurrency, and the shuffles per run the second, or two million.
+ * @return Returns 0 if every run passed its checks.
+ */
+int main(int argc, char *argv[])
+{
+   int most = argc > 1 ? atoi(argv[1]) : thread::hardware_concurrency();
+   most = max(most, 1);
+   long shuffles = argc > 2 ? atol(argv[2]) : 2000000;
+
+   bool passed = true;
+   for (int threads = 1;; threads = min(threads * 2, most)) {
+      for (int count : {ShuffleVerification::CARDS, 5}) {
+         auto tally = ShuffleVerification::run(threads, shuffles, count);
+         vector<string> errors;
+         passed &= ShuffleVerification::check(tally, errors);
+         for (auto &error : errors) {
+            Logger::error(error);
+         }
+
+         ostringstream ss;
+         ss << setw(3) << threads << " thread(s)" << setw(3) << tally.count
+            << " cards" << fixed << setprecision(0) << setw(12)
+            << tally.shuffles / tally.seconds << " shuffles/s"
+            << setprecision(1) << setw(11)
+            << ShuffleVerification::chiSquare(tally) << " chi-square on "
+            << ShuffleVerification::freedom(tally) << " df"
+            << (errors.empty() ? "  ok" : "  FAILED");
+         Logger::console(ss.str());
+      }
+      if (threads == most) {
+         break;
+      }
+   }
+   return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file test/ShuffleVerification.h
+ * @brief Statistical verification and throughput measurement of Deck shuffles.
+ */
+
+#ifndef SHUFFLEVERIFICATION_H
+#define SHUFFLEVERIFICATION_H
+
+#include "../src/game/resources/CardBits.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ShuffleVerification
+ * @brief Shuffles decks across threads and tests where every card lands.
+ * @details Each run counts how often every card ends up at every shuffled
+ * position, counted from the top, and compares the counts with the uniform
+ * distribution by a chi-square test. A biased shuffle, such as one drawing
+ * every swap from the whole deck, fails it within a few million shuffles.
+ */
+class ShuffleVerification
+{
+ public:
+   static constexpr int CARDS = CardBits::DECK_SIZE; ///< Cards per deck
+   static constexpr long BATCH = 4096; ///< Shuffles claimed at a time
+
+   /**
+    * @brief Totals gathered while shuffling.
+    */
+   struct Tally
+   {
+      long shuffles = 0; ///< Decks shuffled
+      int count = 0;     ///< Positions shuffled from the top of each deck
+      std::vector<std::array<long, CARDS>> landed; ///< [position][card]
+      double seconds = 0;                          ///< Wall clock time
+
+      /**
+       * @brief Folds the totals of another worker into this one.
+       *
+       * @param other The other worker's tally.
+       */
+      void merge(const Tally &other);
+   };
+
+   /**
+    * @brief Shuffles and tallies many decks.
+    *
+    * @param threads The number of worker threads.
+    * @param shuffles The number of decks to shuffle.
+    * @param count The number of top cards each shuffle randomizes.
+    * @param seed Seeds the workers' decks.
+    * @return Tally The combined totals of all workers.
+    */
+   static Tally
+   run(int threads, long shuffles, int count, std::uint64_t seed = 1);
+
+   /**
+    * @brief Returns the chi-square statistic of a tally.
+    *
+    * @param tally The totals of a run.
+    * @return double Sum over positions and cards of (seen - expected)^2 /
+    * expected.
+    */
+   static double chiSquare(const Tally &tally);
+
+   /**
+    * @brief Returns the degrees of freedom of a tally's chi-square.
+    *
+    * @param tally The totals of a run.
+    * @return int One less than the cards per position, for each position,
+    * less the positions implied when the whole deck is shuffled.
+    */
+   static int freedom(const Tally &tally);
+
+   /**
+    * @brief Checks a tally against the uniform distribution.
+    * @details Passes when the statistic is within five standard deviations
+    * of its mean, which a fair shuffle fails once in millions of runs.
+    *
+    * @param tally The totals of a run.
+    * @param errors Receives a description of each failure.
+    * @return true if every check passed.
+    */
+   static bool check(const Tally &tally, std::vector<std::string> &errors);
+};
+
+#endif // SHUFFLEVERIFICATION_H
@@ -0,0 +1,110 @@
+/**
+ * @file test/TournamentUnitTest.cpp
+ * @brief Unit tests for the WorkStealingPool and Tournament classes.
+ */
+#include "./TournamentUnitTest.h"
+#include "../../catch_amalgamated.hpp"
+#include "../utils/WorkStealingPool.h"
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+using Test = TournamentUnitTest;
+using namespace std;
+
+/**
+ * @brief Small options.
+ *
+ * @param threads
+ * @return Tournament::Options
+ */
+Tournament::Options Test::small(size_t threads)
+{
+   Tournament::Options options;
+   options.tables = 40;
+   options.games = 30;
+   options.seats = 3;
+   options.threads = threads;
+   return options;
+}
+
+/**
+ * @brief Test section for verifying the work-stealing pool.
+ */
+TEST_CASE("Test Work Stealing Pool")
+{
+   WorkStealingPool pool(4);
+   REQUIRE(pool.size() == 4);
+   REQUIRE(WorkStealingPool::getWorkerIndex() == -1);
+
+   /**
+    * @brief Every task runs once, including tasks submitted by tasks.
+    */
+   SECTION("Nested Tasks")
+   {
+      vector<atomic<int>> runs(1000);
+      atomic<bool> workerIndexed{true};
+      for (int i = 0; i < 100; ++i) {
+         pool.submit([&, i]() {
+            for (int j = 0; j < 9; ++j) {
+               pool.submit([&, i, j]() { runs[100 + i * 9 + j]++; });
+            }
+            int worker = WorkStealingPool::getWorkerIndex();
+            if (worker < 0 || worker >= 4) {
+               workerIndexed = false;
+            }
+            runs[i]++;
+         });
+      }
+      pool.wait();
+      for (auto &count : runs) {
+         REQUIRE(count == 1);
+      }
+      REQUIRE(workerIndexed == true);
+   }
+
+   /**
+    * @brief The pool can be reused after waiting.
+    */
+   SECTION("Reuse")
+   {
+      atomic<long> sum{0};
+      for (int round = 0; round < 3; ++round) {
+         for (int i = 1; i <= 100; ++i) {
+            pool.submit([&sum, i]() { sum += i; });
+         }
+         pool.wait();
+         REQUIRE(sum == 5050 * (round + 1));
+      }
+   }
+}
+
+/**
+ * @brief Test section for verifying parallel tables.
+ */
+TEST_CASE("Test Tournament")
+{
+   auto results = Tournament::run(Test::small(3));
+   REQUIRE(results.tables == 40);
+   REQUIRE(results.games > 0);
+   REQUIRE(results.games <= 40 * 30);
+   REQUIRE(results.seatWins.size() == 3);
+
+   long wins = accumulate(results.seatWins.begin(), results.seatWins.end(), 0L);
+   long categories = accumulate(
+       results.categories.begin(), results.categories.end(), 0L
+   );
+   REQUIRE(wins == categories);
+   REQUIRE(wins == results.games + results.splits); ///< Every pot is paid
+   REQUIRE(results.pots > 0);
+
+   auto single = Tournament::run(Test::small(1));
+   REQUIRE(single.tables == 40);
+   REQUIRE(single.steals == 0);
+
+   ///< Seeded decks and players replay the same hands on any thread count
+   REQUIRE(single.games == results.games);
+   REQUIRE(abs(single.pots - results.pots) < 1e-6 * results.pots);
+   REQUIRE(single.seatWins == results.seatWins);
+}
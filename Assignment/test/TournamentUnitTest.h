@@ -0,0 +1,27 @@
+/**
+ * @file test/TournamentUnitTest.h
+ * @brief Tester class for the work-stealing pool and parallel tables.
+ */
+
+#ifndef TOURNAMENTUNITTEST_H
+#define TOURNAMENTUNITTEST_H
+
+#include "../src/game/simulation/Tournament.h"
+
+/**
+ * @class TournamentUnitTest
+ * @brief Tester class for the work-stealing pool and parallel tables.
+ */
+class TournamentUnitTest
+{
+ public:
+   /**
+    * @brief Returns small tournament options for quick runs.
+    *
+    * @param threads The number of worker threads.
+    * @return Tournament::Options
+    */
+   static Tournament::Options small(size_t threads);
+};
+
+#endif // TOURNAMENTUNITTEST_H
@@ -11,6 +11,7 @@
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 #include <string>
+#include <string_view>
 
 /**
  * @class Logger
@@ -21,15 +22,31 @@ class Logger
  public:
    /**
     * @brief Retrieves Logger instance.
-    * @return Shared pointer to Logger instance.
+    * @return Shared pointer to the calling thread's logger, if one was set,
+    * otherwise the shared console logger.
     */
    static std::shared_ptr<spdlog::logger> &getInstance()
    {
+      std::shared_ptr<spdlog::logger> &local = threadLogger();
+      if (local) {
+         return local;
+      }
       static std::shared_ptr<spdlog::logger> logger =
           spdlog::stdout_color_mt("console");
       return logger;
    }
 
+   /**
+    * @brief Sets the logger used by the calling thread.
+    * @details Worker threads can log to their own sinks, or to none, instead
+    * of contending for the shared console logger.
+    * @param logger The thread's logger, or nullptr for the shared one.
+    */
+   static void setThreadLogger(std::shared_ptr<spdlog::logger> logger)
+   {
+      threadLogger() = std::move(logger);
+   }
+
    /**
     * @brief Sets the logging level.
     * @param level The logging level to set.
@@ -43,7 +60,7 @@ class Logger
     * @brief Logs an error message.
     * @param message The message to log.
     */
-   static void error(std::string message)
+   static void error(std::string_view message)
    {
       getInstance()->error(message);
    }
@@ -52,7 +69,7 @@ class Logger
     * @brief Logs a warning message.
     * @param message The message to log.
     */
-   static void warn(std::string message)
+   static void warn(std::string_view message)
    {
       getInstance()->warn(message);
    }
@@ -61,7 +78,7 @@ class Logger
     * @brief Logs an info message.
     * @param message The message to log.
     */
-   static void info(std::string message)
+   static void info(std::string_view message)
    {
       getInstance()->info(message);
    }
@@ -70,7 +87,7 @@ class Logger
     * @brief Logs a debug message.
     * @param message The message to log.
     */
-   static void debug(std::string message)
+   static void debug(std::string_view message)
    {
       getInstance()->debug(message);
    }
@@ -79,7 +96,7 @@ class Logger
     * @brief Logs a trace message.
     * @param message The message to log.
     */
-   static void trace(std::string message)
+   static void trace(std::string_view message)
    {
       getInstance()->trace(message);
    }
@@ -90,7 +107,9 @@ class Logger
     */
    static void console(std::string message)
    {
-      std::cout << message << std::endl;
+      if (std::ostream *stream = getConsole()) {
+         *stream << message << std::endl;
+      }
    }
 
    /**
@@ -100,18 +119,81 @@ class Logger
     */
    static void console(std::string message, bool newline)
    {
-      if (newline) {
-         std::cout << message << std::endl;
-      } else {
-         std::cout << message;
+      if (std::ostream *stream = getConsole()) {
+         if (newline) {
+            *stream << message << std::endl;
+         } else {
+            *stream << message;
+         }
       }
    }
 
+   /**
+    * @brief Returns where console output goes on the calling thread.
+    * @return The console stream, or nullptr if console output is off.
+    */
+   static std::ostream *getConsole()
+   {
+      return consoleStream();
+   }
+
+   /**
+    * @class Redirect
+    * @brief Sends the calling thread's console output to another stream
+    * until destroyed.
+    */
+   class Redirect
+   {
+    public:
+      /**
+       * @brief Redirects console output.
+       * @param stream The new stream, or nullptr to silence the console.
+       */
+      explicit Redirect(std::ostream *stream) : previous(consoleStream())
+      {
+         consoleStream() = stream;
+      }
+
+      /**
+       * @brief Restores the previous console stream.
+       */
+      ~Redirect()
+      {
+         consoleStream() = previous;
+      }
+
+      Redirect(const Redirect &) = delete;
+      Redirect &operator=(const Redirect &) = delete;
+
+    private:
+      std::ostream *previous; ///< Stream to restore.
+   };
+
  private:
    /**
     * @brief Singleton Constructor.
     */
    Logger();
+
+   /**
+    * @brief Returns the calling thread's console stream.
+    * @details Per thread, so simulations on worker threads can silence or
+    * capture their output without touching each other's.
+    */
+   static std::ostream *&consoleStream()
+   {
+      thread_local std::ostream *stream = &std::cout;
+      return stream;
+   }
+
+   /**
+    * @brief Returns the calling thread's logger override.
+    */
+   static std::shared_ptr<spdlog::logger> &threadLogger()
+   {
+      thread_local std::shared_ptr<spdlog::logger> logger;
+      return logger;
+   }
 };
 
 #endif // LOGGER_H
\ No newline at end of file
@@ -0,0 +1,126 @@
+/**
+ * @file utils/Random.h
+ * @brief Small, fast random number generator with independent streams.
+ */
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class Xoshiro256
+ * @brief The xoshiro256** generator by Blackman and Vigna.
+ * @link https://prng.di.unimi.it/
+ *
+ * Meets the UniformRandomBitGenerator requirements, so it can drive the
+ * standard distributions and algorithms. jump() advances the state by
+ * 2^128 draws, which splits one seed into non-overlapping streams, one
+ * per thread or task.
+ */
+class Xoshiro256
+{
+ public:
+   using result_type = std::uint64_t;
+
+   /**
+    * @brief Seeds the state from one value with splitmix64.
+    * @param seed The seed.
+    */
+   explicit Xoshiro256(std::uint64_t seed = 0x9E3779B97F4A7C15ULL)
+   {
+      for (auto &word : state) {
+         seed += 0x9E3779B97F4A7C15ULL;
+         std::uint64_t z = seed;
+         z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+         z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+         word = z ^ (z >> 31);
+      }
+   }
+
+   static constexpr result_type min() { return 0; }
+
+   static constexpr result_type max()
+   {
+      return std::numeric_limits<result_type>::max();
+   }
+
+   /**
+    * @brief Returns the next 64 random bits.
+    */
+   result_type operator()()
+   {
+      std::uint64_t result = std::rotl(state[1] * 5, 7) * 9;
+      std::uint64_t t = state[1] << 17;
+      state[2] ^= state[0];
+      state[3] ^= state[1];
+      state[1] ^= state[2];
+      state[0] ^= state[3];
+      state[2] ^= t;
+      state[3] = std::rotl(state[3], 45);
+      return result;
+   }
+
+   /**
+    * @brief Returns a value in [0, n) by multiply and shift.
+    * @details The bias is below n / 2^32, far under what sampling resolves.
+    *
+    * @param n The exclusive upper bound, at most 2^32.
+    */
+   std::uint32_t below(std::uint32_t n)
+   {
+      return static_cast<std::uint32_t>(((*this)() >> 32) * n >> 32);
+   }
+
+   /**
+    * @brief Returns a value in [0, n) with no bias at all.
+    * @details Lemire's multiply and shift, redrawing the rare values that
+    * would favour some results. Shuffles use this, since every one of
+    * their outcomes must be exactly equally likely.
+    * @link https://arxiv.org/abs/1805.10941
+    *
+    * @param n The exclusive upper bound, at least 1.
+    */
+   std::uint32_t bounded(std::uint32_t n)
+   {
+      std::uint64_t product = ((*this)() >> 32) * n;
+      if (static_cast<std::uint32_t>(product) < n) {
+         std::uint32_t threshold = -n % n;
+         while (static_cast<std::uint32_t>(product) < threshold) {
+            product = ((*this)() >> 32) * n;
+         }
+      }
+      return static_cast<std::uint32_t>(product >> 32);
+   }
+
+   /**
+    * @brief Advances the state by 2^128 draws.
+    */
+   void jump()
+   {
+      static constexpr std::uint64_t JUMP[] = {
+          0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL,
+          0x39ABDC4529B1661CULL
+      };
+      std::uint64_t next[4] = {0, 0, 0, 0};
+      for (std::uint64_t word : JUMP) {
+         for (int bit = 0; bit < 64; ++bit) {
+            if (word & (1ULL << bit)) {
+               for (int i = 0; i < 4; ++i) {
+                  next[i] ^= state[i];
+               }
+            }
+            (*this)();
+         }
+      }
+      for (int i = 0; i < 4; ++i) {
+         state[i] = next[i];
+      }
+   }
+
+ private:
+   std::uint64_t state[4]; ///< Generator state, never all zero
+};
+
+#endif // RANDOM_H
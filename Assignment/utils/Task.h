@@ -0,0 +1,317 @@
+/**
+ * @file utils/Task.h
+ * @brief Awaitable results for C++20 coroutines.
+ */
+#ifndef TASK_H
+#define TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template <typename T = void> class Task;
+
+/**
+ * @brief Holds what a Task's coroutine returned or threw.
+ */
+template <typename T> struct TaskResult
+{
+   std::optional<T> value;       ///< Set by co_return
+   std::exception_ptr exception; ///< Set by a throw
+
+   /**
+    * @brief Stores the returned value.
+    * @param result The value.
+    */
+   void return_value(T result)
+   {
+      value = std::move(result);
+   }
+
+   /**
+    * @brief Returns the value, or rethrows what the coroutine threw.
+    */
+   T take()
+   {
+      if (exception) {
+         std::rethrow_exception(exception);
+      }
+      return std::move(*value);
+   }
+};
+
+/**
+ * @brief Holds what a Task<void>'s coroutine threw.
+ */
+template <> struct TaskResult<void>
+{
+   std::exception_ptr exception; ///< Set by a throw
+
+   /**
+    * @brief Ends the coroutine.
+    */
+   void return_void() {}
+
+   /**
+    * @brief Rethrows what the coroutine threw, if anything.
+    */
+   void take()
+   {
+      if (exception) {
+         std::rethrow_exception(exception);
+      }
+   }
+};
+
+/**
+ * @class Task
+ * @brief The result of a coroutine, or a value that is ready at once.
+ *
+ * The coroutine starts as soon as it is called and runs until it first
+ * waits on something that is not ready, so a Task whose coroutine never
+ * waits is ready when it is returned. Awaiting a Task suspends the caller
+ * until the coroutine finishes, then resumes it on the same thread, with
+ * no scheduler in between. A Task built from a plain value is ready and
+ * allocates nothing, so a decision that is known at once costs no more
+ * than returning it.
+ *
+ * A suspended coroutine resumes on whichever thread completes what it
+ * waits for. Destroying a Task destroys its coroutine, finished or not.
+ */
+template <typename T> class Task
+{
+ public:
+   /**
+    * @brief The coroutine state behind a Task.
+    */
+   struct promise_type : TaskResult<T>
+   {
+      std::coroutine_handle<> continuation; ///< The caller awaiting it
+
+      Task get_return_object()
+      {
+         return Task(std::coroutine_handle<promise_type>::from_promise(*this)
+         );
+      }
+
+      std::suspend_never initial_suspend() noexcept
+      {
+         return {};
+      }
+
+      /**
+       * @brief Keeps the finished coroutine for its result, and resumes
+       * the caller awaiting it.
+       */
+      auto final_suspend() noexcept
+      {
+         struct Finish
+         {
+            bool await_ready() noexcept
+            {
+               return false;
+            }
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+            {
+               auto next = handle.promise().continuation;
+               return next ? next : std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {}
+         };
+         return Finish{};
+      }
+
+      void unhandled_exception()
+      {
+         this->exception = std::current_exception();
+      }
+   };
+
+   /**
+    * @brief Constructs a ready Task with no coroutine.
+    */
+   Task() = default;
+
+   /**
+    * @brief Constructs a ready Task holding a value.
+    * @param value The value.
+    */
+   template <typename U = T>
+      requires(!std::is_void_v<U>)
+   Task(U value)
+   {
+      ready.value = std::move(value);
+   }
+
+   Task(Task &&other) noexcept
+       : handle(std::exchange(other.handle, nullptr)),
+         ready(std::move(other.ready))
+   {}
+
+   Task &operator=(Task &&other) noexcept
+   {
+      if (this != &other) {
+         if (handle) {
+            handle.destroy();
+         }
+         handle = std::exchange(other.handle, nullptr);
+         ready = std::move(other.ready);
+      }
+      return *this;
+   }
+
+   Task(const Task &) = delete;
+   Task &operator=(const Task &) = delete;
+
+   /**
+    * @brief Destroys the coroutine, finished or not.
+    */
+   ~Task()
+   {
+      if (handle) {
+         handle.destroy();
+      }
+   }
+
+   /**
+    * @brief Returns whether the result is available.
+    */
+   bool isReady() const
+   {
+      return !handle || handle.done();
+   }
+
+   /**
+    * @brief Returns the result, or rethrows what the coroutine threw.
+    * @details Take it once; a value is moved out.
+    * @throws std::logic_error if the coroutine has not finished.
+    */
+   T get()
+   {
+      if (!isReady()) {
+         throw std::logic_error("The task has not finished.");
+      }
+      return handle ? handle.promise().take() : ready.take();
+   }
+
+   bool await_ready() const noexcept
+   {
+      return isReady();
+   }
+
+   void await_suspend(std::coroutine_handle<> caller) noexcept
+   {
+      handle.promise().continuation = caller;
+   }
+
+   T await_resume()
+   {
+      return get();
+   }
+
+ private:
+   /**
+    * @brief Takes ownership of a started coroutine.
+    * @param handle The coroutine.
+    */
+   explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle)
+   {}
+
+   std::coroutine_handle<promise_type> handle; ///< The coroutine, if any
+   TaskResult<T> ready;                        ///< Result without one
+};
+
+/**
+ * @class Reply
+ * @brief A value that arrives from outside, such as a line of input.
+ *
+ * A coroutine awaiting a Reply is suspended until resolve() supplies the
+ * value, then resumes inside resolve(), on the calling thread. A value
+ * resolved before anyone awaits it is kept until the next co_await takes
+ * it. A Reply holds one value and one waiter, and is not thread-safe:
+ * resolve it on the thread that drives its waiter.
+ */
+template <typename T> class Reply
+{
+ public:
+   /**
+    * @brief Suspends the awaiting coroutine until the value arrives.
+    */
+   struct Awaiter
+   {
+      Reply &reply; ///< The awaited Reply
+
+      bool await_ready() const noexcept
+      {
+         return reply.value.has_value();
+      }
+
+      void await_suspend(std::coroutine_handle<> caller) noexcept
+      {
+         reply.waiter = caller;
+      }
+
+      T await_resume()
+      {
+         T result = std::move(*reply.value);
+         reply.value.reset();
+         return result;
+      }
+   };
+
+   Reply() = default;
+   Reply(const Reply &) = delete;
+   Reply &operator=(const Reply &) = delete;
+
+   /**
+    * @brief Supplies the value, resuming the waiter if there is one.
+    * @param result The value; replaces one that was not yet taken.
+    */
+   void resolve(T result)
+   {
+      value = std::move(result);
+      if (auto next = std::exchange(waiter, nullptr)) {
+         next.resume();
+      }
+   }
+
+   /**
+    * @brief Forgets the waiter and any value not yet taken.
+    * @details Call it before destroying a coroutine that is waiting.
+    */
+   void cancel()
+   {
+      waiter = nullptr;
+      value.reset();
+   }
+
+   /**
+    * @brief Returns whether a coroutine is waiting for the value.
+    */
+   bool isWaiting() const
+   {
+      return static_cast<bool>(waiter);
+   }
+
+   /**
+    * @brief Awaits the value.
+    * @details The awaiter refers back to this Reply, so it works even where
+    * a compiler copies the awaited object.
+    */
+   Awaiter operator co_await() noexcept
+   {
+      return Awaiter{*this};
+   }
+
+ private:
+   std::optional<T> value;         ///< Resolved but not yet taken
+   std::coroutine_handle<> waiter; ///< The coroutine awaiting it
+};
+
+#endif // TASK_H
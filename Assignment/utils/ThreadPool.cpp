@@ -0,0 +1,50 @@
+/**
+ * @file utils/ThreadPool.cpp
+ * @brief Implementation of the ThreadPool class.
+ */
+#include "ThreadPool.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool(size_t threads)
+{
+   threads = max<size_t>(threads, 1);
+   workers.reserve(threads);
+   for (size_t i = 0; i < threads; ++i) {
+      workers.emplace_back(&ThreadPool::work, this);
+   }
+}
+
+ThreadPool::~ThreadPool()
+{
+   {
+      lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+   }
+   ready.notify_all();
+   for (auto &worker : workers) {
+      worker.join();
+   }
+}
+
+size_t ThreadPool::size() const
+{
+   return workers.size();
+}
+
+void ThreadPool::work()
+{
+   while (true) {
+      function<void()> task;
+      {
+         unique_lock<std::mutex> lock(mutex);
+         ready.wait(lock, [this]() { return stopping || !tasks.empty(); });
+         if (tasks.empty()) {
+            return; ///< Stopping with nothing left to run
+         }
+         task = move(tasks.front());
+         tasks.pop();
+      }
+      task();
+   }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file utils/ThreadPool.h
+ * @brief Fixed size pool of worker threads.
+ */
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Runs submitted tasks on a fixed set of worker threads.
+ *
+ * Tasks run in submission order as workers become free. The destructor
+ * finishes every queued task before joining the workers.
+ */
+class ThreadPool
+{
+ public:
+   /**
+    * @brief Starts the worker threads.
+    * @param threads The number of workers, at least one.
+    */
+   explicit ThreadPool(
+       size_t threads = std::max(1u, std::thread::hardware_concurrency())
+   );
+
+   /**
+    * @brief Drains the queue and joins the workers.
+    */
+   ~ThreadPool();
+
+   ThreadPool(const ThreadPool &) = delete;
+   ThreadPool &operator=(const ThreadPool &) = delete;
+
+   /**
+    * @brief Queues a task.
+    *
+    * @param task A callable taking no arguments.
+    * @return std::future for the task's result.
+    */
+   template <typename Task> auto submit(Task &&task)
+   {
+      using Result = std::invoke_result_t<Task>;
+      auto job = std::make_shared<std::packaged_task<Result()>>(
+          std::forward<Task>(task)
+      );
+      std::future<Result> result = job->get_future();
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         tasks.emplace([job]() { (*job)(); });
+      }
+      ready.notify_one();
+      return result;
+   }
+
+   /**
+    * @brief Returns the number of worker threads.
+    */
+   size_t size() const;
+
+ private:
+   /**
+    * @brief Runs queued tasks until the pool stops.
+    */
+   void work();
+
+   std::vector<std::thread> workers;        ///< Worker threads
+   std::queue<std::function<void()>> tasks; ///< Pending tasks
+   std::mutex mutex;                        ///< Guards tasks and stopping
+   std::condition_variable ready;           ///< Signals new tasks or stop
+   bool stopping = false;                   ///< Set by the destructor
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,124 @@
+/**
+ * @file utils/WorkStealingPool.cpp
+ * @brief Implementation of the WorkStealingPool class.
+ */
+#include "WorkStealingPool.h"
+
+using namespace std;
+
+namespace
+{
+thread_local int workerIndex = -1;                    ///< Index in its pool
+thread_local const WorkStealingPool *owner = nullptr; ///< The worker's pool
+} // namespace
+
+WorkStealingPool::WorkStealingPool(size_t threads)
+{
+   threads = max<size_t>(threads, 1);
+   for (size_t i = 0; i < threads; ++i) {
+      queues.push_back(make_unique<Queue>());
+   }
+   for (size_t i = 0; i < threads; ++i) {
+      workers.emplace_back(&WorkStealingPool::work, this, i);
+   }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+   wait();
+   {
+      lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+   }
+   ready.notify_all();
+   for (auto &worker : workers) {
+      worker.join();
+   }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+   size_t index = owner == this ? workerIndex : next++ % queues.size();
+   pending++;
+   {
+      lock_guard<std::mutex> lock(queues[index]->mutex);
+      queues[index]->tasks.push_back(move(task));
+   }
+   queued++;
+   {
+      lock_guard<std::mutex> lock(mutex); ///< No worker misses the signal
+   }
+   ready.notify_one();
+}
+
+void WorkStealingPool::wait()
+{
+   unique_lock<std::mutex> lock(mutex);
+   idle.wait(lock, [this]() { return pending == 0; });
+}
+
+size_t WorkStealingPool::size() const
+{
+   return workers.size();
+}
+
+size_t WorkStealingPool::getSteals() const
+{
+   return steals;
+}
+
+int WorkStealingPool::getWorkerIndex()
+{
+   return workerIndex;
+}
+
+bool WorkStealingPool::pop(size_t index, Task &task)
+{
+   Queue &queue = *queues[index];
+   lock_guard<std::mutex> lock(queue.mutex);
+   if (queue.tasks.empty()) {
+      return false;
+   }
+   task = move(queue.tasks.back());
+   queue.tasks.pop_back();
+   queued--;
+   return true;
+}
+
+bool WorkStealingPool::steal(size_t index, Task &task)
+{
+   for (size_t i = 1; i < queues.size(); ++i) {
+      Queue &queue = *queues[(index + i) % queues.size()];
+      lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+         task = move(queue.tasks.front());
+         queue.tasks.pop_front();
+         queued--;
+         steals++;
+         return true;
+      }
+   }
+   return false;
+}
+
+void WorkStealingPool::work(size_t index)
+{
+   workerIndex = static_cast<int>(index);
+   owner = this;
+   while (true) {
+      Task task;
+      if (pop(index, task) || steal(index, task)) {
+         task();
+         if (--pending == 0) {
+            lock_guard<std::mutex> lock(mutex);
+            idle.notify_all();
+         }
+         continue;
+      }
+      unique_lock<std::mutex> lock(mutex);
+      ready.wait(lock, [this]() { return stopping || queued > 0; });
+      if (stopping && queued == 0) {
+         return;
+      }
+   }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file utils/WorkStealingPool.h
+ * @brief Thread pool whose idle workers steal queued tasks from busy ones.
+ */
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs tasks on workers that each keep their own queue.
+ *
+ * A worker takes its newest task first, which keeps the data of tasks it
+ * submitted itself warm in its cache. When its queue runs dry it steals
+ * the oldest task from another worker. Tasks submitted from outside the
+ * pool are dealt to the worker queues in turn.
+ */
+class WorkStealingPool
+{
+ public:
+   using Task = std::function<void()>;
+
+   /**
+    * @brief Starts the worker threads.
+    * @param threads The number of workers, at least one.
+    */
+   explicit WorkStealingPool(
+       size_t threads = std::max(1u, std::thread::hardware_concurrency())
+   );
+
+   /**
+    * @brief Finishes every queued task and joins the workers.
+    */
+   ~WorkStealingPool();
+
+   WorkStealingPool(const WorkStealingPool &) = delete;
+   WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+   /**
+    * @brief Queues a task on the calling worker, or the next one in turn.
+    * @param task The task to run.
+    */
+   void submit(Task task);
+
+   /**
+    * @brief Blocks until every submitted task has finished.
+    */
+   void wait();
+
+   /**
+    * @brief Returns the number of worker threads.
+    */
+   size_t size() const;
+
+   /**
+    * @brief Returns the number of tasks taken from another worker's queue.
+    */
+   size_t getSteals() const;
+
+   /**
+    * @brief Returns the index of the calling worker thread.
+    * @return The worker index, or -1 outside the pool.
+    */
+   static int getWorkerIndex();
+
+ private:
+   /**
+    * @brief One worker's tasks.
+    */
+   struct Queue
+   {
+      std::mutex mutex;       ///< Guards tasks
+      std::deque<Task> tasks; ///< Newest at the back
+   };
+
+   /**
+    * @brief Runs tasks until the pool stops.
+    * @param index The worker index.
+    */
+   void work(size_t index);
+
+   /**
+    * @brief Takes the newest task from a worker's own queue.
+    */
+   bool pop(size_t index, Task &task);
+
+   /**
+    * @brief Takes the oldest task from another worker's queue.
+    */
+   bool steal(size_t index, Task &task);
+
+   std::vector<std::unique_ptr<Queue>> queues; ///< One per worker
+   std::vector<std::thread> workers;           ///< Worker threads
+   std::atomic<size_t> queued{0};              ///< Tasks waiting in queues
+   std::atomic<size_t> pending{0};             ///< Tasks not yet finished
+   std::atomic<size_t> next{0};                ///< Next queue for outsiders
+   std::atomic<size_t> steals{0};              ///< Tasks stolen
+   std::mutex mutex;                           ///< Guards sleeping
+   std::condition_variable ready;              ///< Signals new tasks or stop
+   std::condition_variable idle;               ///< Signals no pending tasks
+   bool stopping = false;                      ///< Set by the destructor
+};
+
+#endif // WORKSTEALINGPOOL_H
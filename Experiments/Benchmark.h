@@ -0,0 +1,58 @@
+/**
+ * @file Experiments/Benchmark.h
+ * @brief Timing helpers shared by the benchmark experiments.
+ */
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "../Assignment/utils/Logger.h"
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+/**
+ * @class Benchmark
+ * @brief Measures and reports the throughput of a workload.
+ */
+class Benchmark
+{
+ public:
+   /**
+    * @brief Runs a workload and returns its wall clock duration.
+    *
+    * @param workload The callable to time.
+    * @return double Elapsed seconds.
+    */
+   template <typename Workload> static double time(Workload &&workload)
+   {
+      auto start = std::chrono::steady_clock::now();
+      workload();
+      std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+      return elapsed.count();
+   }
+
+   /**
+    * @brief Prints the rate and unit cost of a timed workload.
+    *
+    * @param name The workload name.
+    * @param count The number of units processed.
+    * @param seconds The elapsed seconds.
+    * @param unit The unit name, e.g. "hand".
+    */
+   static void report(
+       const std::string &name, double count, double seconds,
+       const std::string &unit
+   )
+   {
+      std::ostringstream ss;
+      ss << std::left << std::setw(44) << name << std::right << std::fixed
+         << std::setprecision(0) << std::setw(14) << count / seconds << " "
+         << unit << "s/s" << std::setprecision(2) << std::setw(12)
+         << seconds * 1e9 / count << " ns/" << unit;
+      Logger::console(ss.str());
+   }
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,255 @@
+/**
+ * @file Experiments/CardBenchmark.cpp
+ * @brief Measures card rank lookups in sorting and hand processing.
+ * @details Sorts seven card hands by Card::getValue and Card::operator<=>,
+ * next to the linear searches they used to perform, and times PokerHand
+ * construction, which sorts and scores each hand in process(). Also
+ * compares regex tokenization of hand notation with HandNotation::scan,
+ * and times building and resetting decks and game engines, a full deal,
+ * draw and showdown cycle that builds hands one card at a time, and the
+ * deck side of a hand: shuffling, dealing, drawing and recycling discards.
+ */
+
+#include "../Assignment/src/game/resources/Card.h"
+#include "../Assignment/src/game/resources/CardBits.h"
+#include "../Assignment/src/game/PokerEngine.h"
+#include "../Assignment/src/game/resources/CardCollection.h"
+#include "../Assignment/src/game/resources/Deck.h"
+#include "../Assignment/src/game/resources/HandNotation.h"
+#include "../Assignment/src/game/resources/PokerHand.h"
+#include "../Assignment/utils/Logger.h"
+#include "Benchmark.h"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+using namespace std;
+using CardPtr = shared_ptr<Card>;
+
+/**
+ * @brief Returns a card value with a linear search, as getValue once did.
+ *
+ * @param card The card.
+ * @return int The card value, or -1.
+ */
+static int linearValue(const Card &card)
+{
+   auto it = find(Card::ranks.begin(), Card::ranks.end(), card.getRank());
+   return it != Card::ranks.end() ? distance(Card::ranks.begin(), it) + 2
+                                  : -1;
+}
+
+/**
+ * @brief Compares card ranks the way operator<=> once did.
+ *
+ * @param a The first card.
+ * @param b The second card.
+ * @return true if a ranks below b.
+ */
+static bool linearLess(const CardPtr &a, const CardPtr &b)
+{
+   auto r = Card::ranks;
+   return distance(r.begin(), find(r.begin(), r.end(), a->getRank())) <
+          distance(r.begin(), find(r.begin(), r.end(), b->getRank()));
+}
+
+/**
+ * @brief Deals random hands of distinct cards.
+ *
+ * @param count Number of hands.
+ * @param size Cards per hand.
+ * @return vector<vector<CardPtr>>
+ */
+static vector<vector<CardPtr>> dealHands(size_t count, int size)
+{
+   mt19937_64 rng(2024);
+   vector<vector<CardPtr>> hands;
+   hands.reserve(count);
+   for (size_t i = 0; i < count; ++i) {
+      CardMask mask = 0;
+      while (CardBits::count(mask) < size) {
+         mask |= CardBits::toMask(rng() % CardBits::DECK_SIZE);
+      }
+      vector<CardPtr> hand;
+      while (mask) {
+         hand.push_back(make_shared<Card>(CardBits::popLowest(mask)));
+      }
+      shuffle(hand.begin(), hand.end(), rng);
+      hands.push_back(hand);
+   }
+   return hands;
+}
+
+/**
+ * @brief Times sorting copies of every hand with a comparator.
+ *
+ * @param name The comparator name.
+ * @param hands The hands to sort.
+ * @param less The comparator.
+ * @param checksum Accumulates a result so the work is kept.
+ */
+template <typename Less>
+static void timeSort(
+    const string &name, const vector<vector<CardPtr>> &hands, Less less,
+    long &checksum
+)
+{
+   vector<CardPtr> scratch;
+   double seconds = Benchmark::time([&]() {
+      for (const auto &hand : hands) {
+         scratch = hand;
+         sort(scratch.begin(), scratch.end(), less);
+         checksum += scratch.front()->getId();
+      }
+   });
+   Benchmark::report(name, hands.size(), seconds, "hand");
+}
+
+/**
+ * @brief The main entry point of the card benchmark.
+ * @return Returns 0 upon successful execution.
+ */
+int main()
+{
+   const size_t count = 1 << 18;
+   long checksum = 0;
+   auto hands = dealHands(count, 7);
+
+   auto linearByValue = [](const CardPtr &a, const CardPtr &b) {
+      return linearValue(*a) < linearValue(*b);
+   };
+   auto byValue = [](const CardPtr &a, const CardPtr &b) {
+      return a->getValue() < b->getValue();
+   };
+   auto byOrder = [](const CardPtr &a, const CardPtr &b) { return *a < b; };
+
+   timeSort("sort, linear search value", hands, linearByValue, checksum);
+   timeSort("sort, Card::getValue", hands, byValue, checksum);
+   timeSort("sort, linear search operator<=>", hands, linearLess, checksum);
+   timeSort("sort, Card::operator<=>", hands, byOrder, checksum);
+
+   auto fives = dealHands(count / 4, 5);
+   double seconds = Benchmark::time([&]() {
+      for (auto &hand : fives) {
+         checksum += PokerHand(hand).getScore();
+      }
+   });
+   Benchmark::report("PokerHand::process()", fives.size(), seconds, "hand");
+
+   vector<string> notations;
+   for (auto &hand : fives) {
+      string notation;
+      for (auto &card : hand) {
+         notation += card->getName() + " ";
+      }
+      notations.push_back(notation);
+   }
+   seconds = Benchmark::time([&]() {
+      for (auto &notation : notations) {
+         regex delimiter("\\s+");
+         sregex_token_iterator token(
+             notation.begin(), notation.end(), delimiter, -1
+         );
+         for (sregex_token_iterator end; token != end; ++token) {
+            checksum += Card(token->str()).getId();
+         }
+      }
+   });
+   Benchmark::report("regex tokenization", notations.size(), seconds, "hand");
+   seconds = Benchmark::time([&]() {
+      CardId ids[HandNotation::MAX_CARDS];
+      for (auto &notation : notations) {
+         checksum += HandNotation::scan(notation, ids).count + ids[0];
+      }
+   });
+   Benchmark::report("HandNotation::scan", notations.size(), seconds, "hand");
+
+   const size_t decks = 1 << 16;
+   seconds = Benchmark::time([&]() {
+      for (size_t i = 0; i < decks; ++i) {
+         checksum += Deck().size();
+      }
+   });
+   Benchmark::report("Deck construction", decks, seconds, "deck");
+   Deck deck;
+   seconds = Benchmark::time([&]() {
+      for (size_t i = 0; i < decks; ++i) {
+         deck.reset();
+         checksum += deck.deal()->getId();
+      }
+   });
+   Benchmark::report("Deck::reset", decks, seconds, "deck");
+   seconds = Benchmark::time([&]() {
+      for (size_t i = 0; i < decks; ++i) {
+         checksum += static_cast<long>(PokerEngine().getPot());
+      }
+   });
+   Benchmark::report("PokerEngine construction", decks, seconds, "engine");
+
+   const size_t rounds = 1 << 15;
+   mt19937_64 rng(7);
+   vector<array<CardId, CardBits::DECK_SIZE>> orders(64);
+   for (auto &order : orders) {
+      iota(order.begin(), order.end(), 0);
+      shuffle(order.begin(), order.end(), rng);
+   }
+   seconds = Benchmark::time([&]() {
+      for (size_t i = 0; i < rounds; ++i) {
+         auto next = orders[i % orders.size()].begin();
+         vector<shared_ptr<PokerHand>> players;
+         for (int p = 0; p < 4; ++p) {
+            players.push_back(make_shared<PokerHand>());
+         }
+         for (int c = 0; c < 5; ++c) {
+            for (auto &hand : players) {
+               *hand += Card::get(*next++);
+            }
+         }
+         for (auto &hand : players) {
+            for (int c = 0; c < 3; ++c) {
+               *hand -= hand->get(0);
+            }
+            for (int c = 0; c < 3; ++c) {
+               *hand += Card::get(*next++);
+            }
+         }
+         long best = 0;
+         for (auto &hand : players) {
+            best = max(best, static_cast<long>(hand->getScore()));
+         }
+         checksum += best;
+      }
+   });
+   Benchmark::report("deal, draw and showdown", rounds, seconds, "round");
+
+   Deck discards(true);
+   seconds = Benchmark::time([&]() {
+      CardPtr dealt[20];
+      for (size_t i = 0; i < rounds; ++i) {
+         deck.reset();
+         discards.clear();
+         deck.shuffle();
+         deck.burn();
+         for (auto &card : dealt) {
+            card = deck.deal();
+         }
+         ///< Four players each return three cards for three new ones
+         for (int c = 0; c < 12; ++c) {
+            discards.add(dealt[c]);
+            dealt[c] = deck.deal();
+         }
+         deck.recycle(discards);
+         deck.shuffle();
+         checksum += deck.size() + dealt[i % 20]->getId();
+      }
+   });
+   Benchmark::report("deck deal, draw and recycle", rounds, seconds, "round");
+
+   Logger::console("Checksum: " + to_string(checksum));
+   return 0;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file Experiments/DrawTableGenerator.cpp
+ * @brief Writes the draw outcome table, then times lookups in it.
+ * @details The first argument names the table file, DrawTable::DEFAULT_PATH
+ * by default. Reports how long generating and opening the table take, then
+ * the rate of optimal discard lookups against computing each discard with
+ * DrawOptimizer, over the same random hands.
+ */
+
+#include "../Assignment/src/game/analysis/DrawOptimizer.h"
+#include "../Assignment/src/game/analysis/DrawTable.h"
+#include "../Assignment/utils/Logger.h"
+#include "Benchmark.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+constexpr int HANDS = 1000000; ///< Random hands looked up
+
+/**
+ * @brief The main entry point of the draw table generator.
+ * @return Returns 0 upon successful execution.
+ */
+int main(int argc, char *argv[])
+{
+   const string path = argc > 1 ? argv[1] : DrawTable::DEFAULT_PATH;
+   bool written = false;
+   double seconds =
+       Benchmark::time([&]() { written = DrawTable::generate(path); });
+   if (!written) {
+      return 1;
+   }
+   Logger::console(
+       "Wrote " + path + " in " + to_string(seconds) + " s, " +
+       to_string(SuitIsomorphism::CLASS_COUNT) + " classes"
+   );
+
+   DrawTable table;
+   seconds = Benchmark::time([&]() { table.open(path); });
+   Benchmark::report("Open", 1, seconds, "table");
+
+   ///< Random five card hands, drawn up front
+   vector<CardId> ids(HANDS * DrawOptimizer::HAND_SIZE);
+   vector<CardId> deck(CardBits::DECK_SIZE);
+   iota(deck.begin(), deck.end(), 0);
+   mt19937_64 rng(0);
+   for (int hand = 0; hand < HANDS; ++hand) {
+      shuffle(deck.begin(), deck.end(), rng);
+      copy_n(deck.begin(), DrawOptimizer::HAND_SIZE, &ids[hand * 5]);
+   }
+
+   unsigned checksum = 0;
+   for (int pass = 1; pass <= 2; ++pass) {
+      seconds = Benchmark::time([&]() {
+         DrawOptimizer::Choice choice;
+         for (int hand = 0; hand < HANDS; ++hand) {
+            table.best(&ids[hand * 5], choice);
+            checksum += choice.pattern;
+         }
+      });
+      Benchmark::report(
+          "Table lookup, pass " + to_string(pass), HANDS, seconds, "hand"
+      );
+   }
+   seconds = Benchmark::time([&]() {
+      for (int hand = 0; hand < HANDS; ++hand) {
+         checksum -= DrawOptimizer::best(&ids[hand * 5]).pattern;
+      }
+   });
+   Benchmark::report("DrawOptimizer", HANDS, seconds, "hand");
+   Logger::console("Checksum " + to_string(checksum));
+   return 0;
+}
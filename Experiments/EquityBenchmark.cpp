@@ -0,0 +1,75 @@
+/**
+ * @file Experiments/EquityBenchmark.cpp
+ * @brief Measures Monte Carlo draw equity latency.
+ * @details Times 100,000 sample estimates for a pair drawing three cards
+ * against three opponents, at 1, 2, 4, ... threads up to the hardware
+ * concurrency or the first argument, and how many samples a 10 ms budget
+ * buys.
+ */
+
+#include "../Assignment/src/game/analysis/DrawEquity.h"
+#include "../Assignment/src/game/resources/PokerHand.h"
+#include "../Assignment/utils/Logger.h"
+#include "Benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief The main entry point of the equity benchmark.
+ * @return Returns 0 upon successful execution.
+ */
+int main(int argc, char *argv[])
+{
+   int most = argc > 1 ? atoi(argv[1]) : thread::hardware_concurrency();
+   most = max(most, 1);
+   const long samples = 100000;
+   const int repeats = 20;
+
+   auto hand = make_shared<PokerHand>("7H 7D KC 4S 2D");
+   vector<int> discards;
+   for (int i = 0; i < static_cast<int>(hand->size()); ++i) {
+      if (hand->get(i)->getRank() != '7') {
+         discards.push_back(i);
+      }
+   }
+   CardCollection dead;
+
+   for (int threads = 1;; threads = min(threads * 2, most)) {
+      DrawEquity equity(threads);
+      DrawEquity::Result result;
+      double seconds = Benchmark::time([&]() {
+         for (int i = 0; i < repeats; ++i) {
+            result = equity.calculate(hand, discards, 3, dead, samples, i);
+         }
+      });
+      Benchmark::report(
+          to_string(threads) + " thread(s), 100k samples", repeats, seconds,
+          "estimate"
+      );
+      Benchmark::report(
+          to_string(threads) + " thread(s), per sample", repeats * samples,
+          seconds, "sample"
+      );
+
+      auto timed = equity.calculate(
+          hand, discards, 3, dead, chrono::microseconds(10000)
+      );
+      ostringstream ss;
+      ss << "   win " << result.win << ", tie " << result.tie << ", loss "
+         << result.loss << "; 10 ms budget drew " << timed.samples
+         << " samples";
+      Logger::console(ss.str());
+      if (threads == most) {
+         break;
+      }
+   }
+   return 0;
+}
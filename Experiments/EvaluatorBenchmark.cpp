@@ -0,0 +1,127 @@
+/**
+ * @file Experiments/EvaluatorBenchmark.cpp
+ * @brief Measures hand evaluation throughput.
+ * @details Compares the five card table lookup, the single pass six and
+ * seven card evaluation, each batch kernel, and full PokerHand construction.
+ */
+
+#include "../Assignment/src/game/resources/CardBits.h"
+#include "../Assignment/src/game/resources/HandEvaluator.h"
+#include "../Assignment/src/game/resources/PokerHand.h"
+#include "../Assignment/utils/Logger.h"
+#include "Benchmark.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Deals random sets of distinct cards.
+ *
+ * @param count Number of sets.
+ * @param size Cards per set.
+ * @return vector<CardMask>
+ */
+static vector<CardMask> dealMasks(size_t count, int size)
+{
+   mt19937_64 rng(2024);
+   vector<CardMask> masks(count);
+   for (auto &mask : masks) {
+      mask = 0;
+      while (CardBits::count(mask) < size) {
+         mask |= CardBits::toMask(rng() % CardBits::DECK_SIZE);
+      }
+   }
+   return masks;
+}
+
+/**
+ * @brief The main entry point of the evaluator benchmark.
+ * @return Returns 0 upon successful execution.
+ */
+int main()
+{
+   const size_t count = 1 << 20;
+   const int passes = 16;
+   uint64_t checksum = 0;
+
+   HandEvaluator::evaluate(CardBits::FULL_DECK >> 45); ///< Build tables
+
+   for (int size = 5; size <= 7; ++size) {
+      vector<CardMask> masks = dealMasks(count, size);
+      double seconds = Benchmark::time([&]() {
+         for (int pass = 0; pass < passes; ++pass) {
+            for (CardMask mask : masks) {
+               checksum += HandEvaluator::evaluate(mask);
+            }
+         }
+      });
+      Benchmark::report(
+          "HandEvaluator::evaluate(CardMask), " + to_string(size) + " cards",
+          1.0 * count * passes,
+          seconds,
+          "hand"
+      );
+
+      vector<uint16_t> ranks(count);
+      for (int kernel = HandEvaluator::SCALAR_KERNEL;
+           kernel <= HandEvaluator::getBatchKernel(); ++kernel) {
+         auto batch = static_cast<HandEvaluator::BatchKernel>(kernel);
+         seconds = Benchmark::time([&]() {
+            for (int pass = 0; pass < passes; ++pass) {
+               HandEvaluator::evaluateBatch(
+                   masks.data(), ranks.data(), count, batch
+               );
+               checksum += ranks[pass];
+            }
+         });
+         Benchmark::report(
+             "evaluateBatch " + HandEvaluator::getBatchKernelName(batch) +
+                 ", " + to_string(size) + " cards",
+             1.0 * count * passes,
+             seconds,
+             "hand"
+         );
+      }
+   }
+
+   vector<CardMask> masks = dealMasks(count, 5);
+   vector<uint32_t> codes;
+   codes.reserve(count * 5);
+   for (CardMask mask : masks) {
+      while (mask) {
+         codes.push_back(HandEvaluator::encode(CardBits::popLowest(mask)));
+      }
+   }
+   double seconds = Benchmark::time([&]() {
+      for (int pass = 0; pass < passes; ++pass) {
+         for (size_t i = 0; i < codes.size(); i += 5) {
+            checksum += HandEvaluator::evaluate(
+                codes[i], codes[i + 1], codes[i + 2], codes[i + 3], codes[i + 4]
+            );
+         }
+      }
+   });
+   Benchmark::report(
+       "HandEvaluator::evaluate(c1..c5)", 1.0 * count * passes, seconds, "hand"
+   );
+
+   const size_t objects = 1 << 16;
+   seconds = Benchmark::time([&]() {
+      for (size_t i = 0; i < objects; ++i) {
+         CardCollection cards(masks[i]);
+         vector<shared_ptr<Card>> hand;
+         for (size_t j = 0; j < cards.size(); ++j) {
+            hand.push_back(cards.get(j));
+         }
+         checksum += PokerHand(hand).getScore();
+      }
+   });
+   Benchmark::report("PokerHand construction", objects, seconds, "hand");
+
+   Logger::console("Checksum: " + to_string(checksum));
+   return 0;
+}
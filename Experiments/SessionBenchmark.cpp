@@ -0,0 +1,155 @@
+/**
+ * @file Experiments/SessionBenchmark.cpp
+ * @brief Measures what it costs to set up each hand of a session.
+ * @details Plays hands at a headless PokerEngine two ways: building a new
+ * engine, decks and players for every hand, as one run of PokerGame does,
+ * and playing a session at one table with PokerEngine::playSession. Heap
+ * allocations are counted by replacing the global operator new, and
+ * reported per hand for the whole hand and for its setup alone, which for
+ * a session is the reset() between hands. All-in bets break players even
+ * with large balances, so session players are topped up whenever a session
+ * ends early. The first argument sets the number of hands.
+ */
+
+#include "../Assignment/src/game/PokerEngine.h"
+#include "../Assignment/src/game/player/AIPokerPlayer.h"
+#include "../Assignment/utils/Logger.h"
+#include "Benchmark.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+constexpr double BALANCE = 1e9; ///< Starting balance of each player
+
+namespace
+{
+long allocations = 0; ///< Calls to the global operator new
+} // namespace
+
+void *operator new(size_t size)
+{
+   ++allocations;
+   if (void *memory = malloc(size ? size : 1)) {
+      return memory;
+   }
+   throw bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+   free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+   free(memory);
+}
+
+/**
+ * @brief Seats AI players at a new headless table.
+ *
+ * @param seats The number of players.
+ * @param players Receives the players seated.
+ * @return shared_ptr<PokerEngine> The table.
+ */
+shared_ptr<PokerEngine>
+seatTable(int seats, vector<shared_ptr<AIPokerPlayer>> &players)
+{
+   auto engine = make_shared<PokerEngine>();
+   engine->setHeadless(true);
+   players.clear();
+   for (int id = 1; id <= seats; ++id) {
+      players.push_back(make_shared<AIPokerPlayer>(engine, id, BALANCE));
+      engine->addPlayer(players.back());
+   }
+   return engine;
+}
+
+/**
+ * @brief Prints allocations per hand.
+ *
+ * @param name What was counted.
+ * @param count The allocations counted.
+ * @param hands The number of hands.
+ */
+void reportAllocations(const string &name, long count, long hands)
+{
+   ostringstream ss;
+   ss << fixed << setprecision(2) << name << ": " << count / double(hands)
+      << " allocations/hand";
+   Logger::console(ss.str());
+}
+
+/**
+ * @brief The main entry point of the session benchmark.
+ * @return Returns 0 upon successful execution.
+ */
+int main(int argc, char *argv[])
+{
+   const long hands = argc > 1 ? atol(argv[1]) : 100000;
+   Logger::set_level(spdlog::level::warn);
+
+   vector<shared_ptr<AIPokerPlayer>> players;
+   for (int seats : {2, 4, 7}) {
+      const string table = to_string(seats) + " players";
+
+      ///< A new table for every hand
+      long setup = 0, before = allocations;
+      double setupSeconds = 0;
+      double seconds = Benchmark::time([&]() {
+         for (long hand = 0; hand < hands; ++hand) {
+            long start = allocations;
+            shared_ptr<PokerEngine> engine;
+            setupSeconds +=
+                Benchmark::time([&]() { engine = seatTable(seats, players); });
+            setup += allocations - start;
+            engine->startGame();
+            engine->clearPlayers();
+         }
+      });
+      Benchmark::report(table + ", new table per hand", hands, seconds, "hand");
+      Benchmark::report(
+          table + ", new table setup", hands, setupSeconds, "hand"
+      );
+      reportAllocations("Whole hand", allocations - before, hands);
+      reportAllocations("Setup", setup, hands);
+
+      ///< One table for the whole session
+      auto engine = seatTable(seats, players);
+      engine->playSession(1).get(); ///< Warm the hands and decks
+      before = allocations;
+      long played = 0;
+      seconds = Benchmark::time([&]() {
+         while (played < hands) {
+            played += engine->playSession(hands - played).get();
+            for (auto &player : players) {
+               player->collect(BALANCE - player->getBalance());
+            }
+         }
+      });
+      long total = allocations - before;
+
+      ///< The reset() between hands, timed and counted on its own
+      setup = 0;
+      setupSeconds = 0;
+      for (long hand = 0; hand < hands; ++hand) {
+         engine->startGame();
+         long start = allocations;
+         setupSeconds += Benchmark::time([&]() { engine->reset(); });
+         setup += allocations - start;
+      }
+      Benchmark::report(table + ", session", played, seconds, "hand");
+      Benchmark::report(table + ", session setup", hands, setupSeconds, "hand");
+      reportAllocations("Whole hand", total, played);
+      reportAllocations("Setup", setup, hands);
+      engine->clearPlayers();
+   }
+   return 0;
+}
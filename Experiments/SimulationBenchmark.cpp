@@ -0,0 +1,92 @@
+/**
+ * @file Experiments/SimulationBenchmark.cpp
+ * @brief Measures how many complete games a headless engine plays.
+ * @details Seats AI players at a headless PokerEngine and plays complete
+ * hands back to back, ante to showdown, with console output discarded.
+ * Pots are not paid out, so a fresh table sits down every TABLE_GAMES
+ * games before the players run out of money for the ante. Each table size
+ * is timed again with every hand recorded to a HistoryWriter in the
+ * temporary directory, to show what recording costs, and the recorded
+ * games are then replayed as a fixed workload. The first argument sets the
+ * number of games.
+ */
+
+#include "../Assignment/src/game/PokerEngine.h"
+#include "../Assignment/src/game/history/HistoryWriter.h"
+#include "../Assignment/src/game/player/AIPokerPlayer.h"
+#include "../Assignment/src/game/simulation/Replay.h"
+#include "../Assignment/utils/Logger.h"
+#include "Benchmark.h"
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+constexpr long TABLE_GAMES = 20; ///< Games per table
+
+/**
+ * @brief The main entry point of the simulation benchmark.
+ * @return Returns 0 upon successful execution.
+ */
+int main(int argc, char *argv[])
+{
+   const long games = argc > 1 ? atol(argv[1]) : 100000;
+   Logger::set_level(spdlog::level::warn);
+
+   const string path =
+       (filesystem::temp_directory_path() / "simulation_benchmark.phh")
+           .string();
+   for (int seats : {2, 4, 7}) {
+      for (bool recording : {false, true}) {
+         filesystem::remove(path);
+         auto recorder =
+             recording ? make_shared<HistoryWriter>(path) : nullptr;
+         shared_ptr<PokerEngine> engine;
+         long long checksum = 0;
+         double seconds = Benchmark::time([&]() {
+            for (long game = 0; game < games; ++game) {
+               if (game % TABLE_GAMES == 0) {
+                  engine = make_shared<PokerEngine>();
+                  engine->setHeadless(true);
+                  engine->setRecorder(recorder);
+                  for (int id = 1; id <= seats; ++id) {
+                     auto player =
+                         make_shared<AIPokerPlayer>(engine, id, 1e9);
+                     engine->addPlayer(player);
+                  }
+               }
+               engine->reset();
+               engine->startGame();
+               checksum += engine->endGame(false).rbegin()->first;
+            }
+            if (recorder) {
+               recorder->flush();
+            }
+         });
+         Benchmark::report(
+             to_string(seats) + " players, headless" +
+                 (recording ? ", recorded" : ""),
+             games, seconds, "game"
+         );
+         Logger::console("Checksum: " + to_string(checksum));
+         if (recorder) {
+            Logger::console(
+                "History: " + to_string(recorder->getBytes() / games) +
+                " bytes/game"
+            );
+            auto replayed = Replay::run(path);
+            Benchmark::report(
+                to_string(seats) + " players, replayed", replayed.hands,
+                replayed.seconds, "game"
+            );
+            Logger::console(
+                "Mismatches: " + to_string(replayed.mismatches)
+            );
+         }
+      }
+   }
+   filesystem::remove(path);
+   return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file Experiments/TournamentRunner.cpp
+ * @brief Plays many headless poker tables in parallel.
+ * @details Arguments are the number of tables, the hand limit per table and
+ * the most worker threads. Runs at 1, 2, 4, ... threads up to that limit
+ * and reports tables and hands per second, then the totals of the last run.
+ */
+
+#include "../Assignment/src/game/resources/PokerHand.h"
+#include "../Assignment/src/game/simulation/Tournament.h"
+#include "../Assignment/utils/Logger.h"
+#include "Benchmark.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+/**
+ * @brief The main entry point of the tournament runner.
+ * @return Returns 0 upon successful execution.
+ */
+int main(int argc, char *argv[])
+{
+   Tournament::Options options;
+   options.tables = argc > 1 ? atoi(argv[1]) : 2000;
+   options.games = argc > 2 ? atoi(argv[2]) : 100;
+   int most = argc > 3 ? atoi(argv[3]) : thread::hardware_concurrency();
+   most = max(most, 1);
+   Logger::set_level(spdlog::level::warn);
+
+   Tournament::Results results;
+   for (int threads = 1;; threads = min(threads * 2, most)) {
+      options.threads = threads;
+      results = Tournament::run(options);
+      string label = to_string(threads) + " thread(s), ";
+      Benchmark::report(
+          label + "tables", results.tables, results.seconds, "table"
+      );
+      Benchmark::report(
+          label + "hands", results.games, results.seconds, "hand"
+      );
+      Logger::console("   " + to_string(results.steals) + " tables stolen");
+      if (threads == most) {
+         break;
+      }
+   }
+
+   Logger::console("");
+   Logger::console(
+       to_string(results.tables) + " tables, " +
+       to_string(results.finished) + " played down to one player, " +
+       to_string(results.games) + " hands, " + to_string(results.splits) +
+       " split pots"
+   );
+   Logger::console("Winning hands:");
+   for (int i = 0; i < PokerHand::INVALID_HAND; ++i) {
+      Logger::console(
+          "   " + PokerHand::HAND_NAMES.at(i) + ": " +
+          to_string(results.categories[i])
+      );
+   }
+   for (size_t seat = 0; seat < results.seatWins.size(); ++seat) {
+      Logger::console(
+          "Seat " + to_string(seat + 1) + " won " +
+          to_string(results.seatWins[seat]) + " hands"
+      );
+   }
+   return 0;
+}